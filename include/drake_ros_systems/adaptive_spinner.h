@@ -0,0 +1,282 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "drake/common/drake_assert.h"
+#include "drake/common/drake_copyable.h"
+
+#include "ros/callback_queue.h"
+#include "ros/ros.h"
+
+namespace drake_ros_systems {
+
+using namespace drake;
+
+/**
+ * Options of AdaptiveSpinner.
+ */
+struct AdaptiveSpinnerOptions {
+  /// Bounds of the number of spinner threads.
+  int min_threads{1};
+  int max_threads{4};
+
+  /// How often the load is sampled and the thread count reconsidered, in
+  /// seconds.
+  double sample_period{0.1};
+
+  /// A sample is "overloaded" if the threads were busy running callbacks for
+  /// more than this fraction of their time, or if the queue still had
+  /// callbacks waiting at the end of it while no thread found itself unable
+  /// to run them. A backlog that the threads cannot share, e.g. of one
+  /// subscription, whose callbacks roscpp runs one at a time, is not helped
+  /// by more threads.
+  double grow_busy_fraction{0.8};
+
+  /// A sample is "idle" if the threads were busy for less than this fraction
+  /// of their time and the queue was drained, or its backlog unshareable.
+  double shrink_busy_fraction{0.3};
+
+  /// Consecutive overloaded samples before a thread is added.
+  int grow_after_samples{2};
+
+  /// Consecutive idle samples before a thread is removed. Larger than
+  /// grow_after_samples, so that bursts are absorbed quickly but the pool
+  /// does not oscillate.
+  int shrink_after_samples{20};
+
+  /// How long a worker sleeps when it finds no callback it can run, in
+  /// seconds, which bounds the extra latency of a callback arriving at an
+  /// idle pool.
+  double idle_poll_period{0.001};
+};
+
+/**
+ * Statistics of an AdaptiveSpinner.
+ */
+struct AdaptiveSpinnerStats {
+  int num_threads{0};
+
+  /// Load of the last sample.
+  double busy_fraction{0.0};
+  bool backlogged{false};
+
+  /// Callbacks run and the longest one, in seconds, since start().
+  std::uint64_t num_callbacks{0};
+  double max_callback_duration{0.0};
+
+  /// Thread count changes since start().
+  int num_grows{0};
+  int num_shrinks{0};
+
+  /// Why the thread count last changed, e.g. "grow to 3: busy 0.91".
+  std::string last_decision;
+};
+
+/**
+ * Services a ros::CallbackQueue with a pool of threads whose size follows the
+ * observed load, as a replacement for a ros::AsyncSpinner with a fixed
+ * thread count.
+ *
+ * Every sample period a monitor thread measures which fraction of the
+ * workers' time went into callbacks, whether callbacks were left waiting in
+ * the queue (roscpp does not expose the queue depth), and whether idle
+ * workers had to leave them waiting. It then adds or
+ * removes one worker, within [min_threads, max_threads], once the load has
+ * stayed beyond the grow or shrink threshold for enough consecutive samples.
+ * A removed worker finishes its current callback before exiting.
+ */
+class AdaptiveSpinner {
+ public:
+  DRAKE_NO_COPY_NO_MOVE_NO_ASSIGN(AdaptiveSpinner)
+
+  /**
+   * @param[in] options Bounds and hysteresis of the pool.
+   *
+   * @param queue The queue to service; the global one by default.
+   */
+  explicit AdaptiveSpinner(
+      const AdaptiveSpinnerOptions& options = AdaptiveSpinnerOptions{},
+      ros::CallbackQueue* queue = ros::getGlobalCallbackQueue())
+      : options_(options), queue_(queue) {
+    DRAKE_DEMAND(queue_ != nullptr);
+    DRAKE_DEMAND(options_.min_threads >= 1);
+    DRAKE_DEMAND(options_.max_threads >= options_.min_threads);
+    DRAKE_DEMAND(options_.sample_period > 0.0);
+    DRAKE_DEMAND(options_.shrink_busy_fraction <=
+                 options_.grow_busy_fraction);
+    DRAKE_DEMAND(options_.grow_after_samples >= 1);
+    DRAKE_DEMAND(options_.shrink_after_samples >= 1);
+    DRAKE_DEMAND(options_.idle_poll_period > 0.0);
+  }
+
+  ~AdaptiveSpinner() { stop(); }
+
+  /// Starts min_threads workers and the monitor.
+  void start() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (running_) return;
+    running_ = true;
+    stats_ = AdaptiveSpinnerStats{};
+    for (int i = 0; i < options_.min_threads; ++i) AddWorker();
+    monitor_ = std::thread(&AdaptiveSpinner::Monitor, this);
+  }
+
+  /// Stops and joins all threads. Callbacks still queued are left there.
+  void stop() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (!running_) return;
+      running_ = false;
+    }
+    monitor_condition_variable_.notify_all();
+    monitor_.join();
+    for (std::unique_ptr<Worker>& worker : workers_) worker->stop = true;
+    for (std::unique_ptr<Worker>& worker : workers_) worker->thread.join();
+    workers_.clear();
+  }
+
+  AdaptiveSpinnerStats get_stats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return stats_;
+  }
+
+ private:
+  struct Worker {
+    std::thread thread;
+    std::atomic<bool> stop{false};
+  };
+
+  void AddWorker() {
+    workers_.push_back(std::make_unique<Worker>());
+    Worker* worker = workers_.back().get();
+    worker->thread = std::thread(&AdaptiveSpinner::Spin, this, worker);
+    stats_.num_threads = static_cast<int>(workers_.size());
+  }
+
+  // Only the callbacks themselves count as busy time: workers look for work
+  // without blocking and sleep between looks, since time spent blocked in
+  // callOne() waiting for a callback cannot be told apart from running it.
+  // callOne() also returns TryAgain without running anything when the only
+  // waiting callbacks belong to a subscription another worker is serving.
+  void Spin(Worker* worker) {
+    using Clock = std::chrono::steady_clock;
+    const auto idle_poll_period =
+        std::chrono::duration<double>(options_.idle_poll_period);
+    while (!worker->stop && ros::ok()) {
+      if (queue_->isEmpty()) {
+        std::this_thread::sleep_for(idle_poll_period);
+        continue;
+      }
+      const Clock::time_point start = Clock::now();
+      const ros::CallbackQueue::CallOneResult result =
+          queue_->callOne(ros::WallDuration(0.0));
+      if (result != ros::CallbackQueue::Called) {
+        if (result == ros::CallbackQueue::TryAgain) ++num_try_agains_;
+        std::this_thread::sleep_for(idle_poll_period);
+        continue;
+      }
+      const std::int64_t duration =
+          std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() -
+                                                               start)
+              .count();
+      busy_nanoseconds_ += duration;
+      ++num_callbacks_;
+      std::int64_t longest = max_callback_nanoseconds_;
+      while (duration > longest &&
+             !max_callback_nanoseconds_.compare_exchange_weak(longest,
+                                                              duration)) {
+      }
+    }
+  }
+
+  void Monitor() {
+    const auto period = std::chrono::duration<double>(options_.sample_period);
+    int overloaded_samples = 0;
+    int idle_samples = 0;
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (running_) {
+      monitor_condition_variable_.wait_for(lock, period);
+      if (!running_) break;
+
+      const int num_threads = static_cast<int>(workers_.size());
+      const double busy_fraction =
+          busy_nanoseconds_.exchange(0) * 1e-9 /
+          (options_.sample_period * num_threads);
+      const bool backlogged = !queue_->isEmpty();
+      const bool unshareable = num_try_agains_.exchange(0) > 0;
+      stats_.busy_fraction = busy_fraction;
+      stats_.backlogged = backlogged;
+      stats_.num_callbacks = num_callbacks_;
+      stats_.max_callback_duration = max_callback_nanoseconds_ * 1e-9;
+
+      const bool overloaded =
+          busy_fraction > options_.grow_busy_fraction ||
+          (backlogged && !unshareable);
+      const bool idle = (!backlogged || unshareable) &&
+                        busy_fraction < options_.shrink_busy_fraction;
+      overloaded_samples = overloaded ? overloaded_samples + 1 : 0;
+      idle_samples = idle ? idle_samples + 1 : 0;
+
+      if (overloaded_samples >= options_.grow_after_samples &&
+          num_threads < options_.max_threads) {
+        AddWorker();
+        ++stats_.num_grows;
+        stats_.last_decision = Describe("grow", busy_fraction, backlogged);
+        overloaded_samples = 0;
+      } else if (idle_samples >= options_.shrink_after_samples &&
+                 num_threads > options_.min_threads) {
+        std::unique_ptr<Worker> worker = std::move(workers_.back());
+        workers_.pop_back();
+        stats_.num_threads = static_cast<int>(workers_.size());
+        ++stats_.num_shrinks;
+        stats_.last_decision = Describe("shrink", busy_fraction, backlogged);
+        idle_samples = 0;
+        // Joined without the lock, so that get_stats() does not wait on a
+        // long callback.
+        worker->stop = true;
+        lock.unlock();
+        worker->thread.join();
+        lock.lock();
+      }
+    }
+  }
+
+  // Must be called with mutex_ held, after the change.
+  std::string Describe(const char* action, double busy_fraction,
+                       bool backlogged) const {
+    return std::string(action) + " to " + std::to_string(workers_.size()) +
+           ": busy " + std::to_string(busy_fraction) +
+           (backlogged ? ", backlogged" : "");
+  }
+
+  const AdaptiveSpinnerOptions options_;
+  ros::CallbackQueue* const queue_{};
+
+  // Accumulated by the workers, read by the monitor.
+  std::atomic<std::int64_t> busy_nanoseconds_{0};
+  std::atomic<std::uint64_t> num_callbacks_{0};
+  std::atomic<std::int64_t> max_callback_nanoseconds_{0};
+  // callOne() calls that found only callbacks already being served, since
+  // the last sample.
+  std::atomic<std::uint64_t> num_try_agains_{0};
+
+  // The mutex that guards everything below. Only the monitor changes
+  // workers_ while running.
+  mutable std::mutex mutex_;
+  std::condition_variable monitor_condition_variable_;
+  bool running_{false};
+  std::vector<std::unique_ptr<Worker>> workers_;
+  std::thread monitor_;
+  AdaptiveSpinnerStats stats_;
+};
+
+}  // namespace drake_ros_systems
@@ -0,0 +1,259 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+#include <Eigen/Core>
+
+#include "drake/common/drake_assert.h"
+#include "drake/perception/point_cloud.h"
+
+#include "drake_ros_systems/CompactPointCloud.h"
+
+namespace drake_ros_systems {
+
+using namespace drake;
+
+/**
+ * Options of CompactPointCloudEncoder.
+ */
+struct CompactPointCloudOptions {
+  /// Smallest quantization step, in meters. The actual step on each axis is
+  /// the larger of this and the bounding box extent / 65534, so the
+  /// reconstruction error is at most half of it. Coarser steps make more
+  /// chunks delta-packable.
+  float resolution{0.0f};
+
+  /// Whether to leave colors out even if the cloud has them.
+  bool drop_rgbs{false};
+
+  /// Number of points per delta-packed chunk.
+  int chunk_size{64};
+};
+
+/**
+ * Encodes perception::PointCloud objects into CompactPointCloud messages:
+ * positions are quantized to 16-bit fixed point relative to the cloud's
+ * bounding box and packed in chunks, each of which stores 8-bit differences
+ * between consecutive points when they all fit. Colors, when kept, are
+ * appended as 3 bytes per point. Non-finite points survive the round trip as
+ * NaN.
+ *
+ * The quantization and the per-chunk delta tests are Eigen array
+ * expressions. The encoder keeps its scratch buffers between calls, so an
+ * instance should be reused for every cloud of a stream.
+ */
+class CompactPointCloudEncoder {
+ public:
+  explicit CompactPointCloudEncoder(
+      const CompactPointCloudOptions& options = CompactPointCloudOptions{})
+      : options_(options) {
+    DRAKE_DEMAND(options_.resolution >= 0.0f);
+    DRAKE_DEMAND(options_.chunk_size >= 1 &&
+                 options_.chunk_size <= std::numeric_limits<uint16_t>::max());
+  }
+
+  const CompactPointCloudOptions& get_options() const { return options_; }
+
+  /// Encodes @p cloud into @p message. The header is left untouched.
+  void Encode(const perception::PointCloud& cloud,
+              CompactPointCloud* message) {
+    DRAKE_DEMAND(message != nullptr);
+    const int num_points = cloud.size();
+    const auto xyzs = cloud.xyzs().array();
+
+    // The largest quantized value of a finite coordinate; the next one marks
+    // non-finite points.
+    const float kMaxQuantized = 65534.0f;
+    const std::uint16_t kInvalid = 65535;
+
+    // Bounding box of the finite coordinates. Eigen asserts on reductions of
+    // empty arrays, so an empty cloud keeps the empty box.
+    const float kInf = std::numeric_limits<float>::infinity();
+    const auto finite = xyzs.isFinite();
+    Eigen::Array3f lo = Eigen::Array3f::Zero();
+    Eigen::Array3f hi = Eigen::Array3f::Zero();
+    if (num_points > 0) {
+      lo = finite.select(xyzs, kInf).rowwise().minCoeff();
+      hi = finite.select(xyzs, -kInf).rowwise().maxCoeff();
+      if (!(lo <= hi).all()) {
+        lo.setZero();
+        hi.setZero();
+      }
+    }
+    Eigen::Array3f scale =
+        ((hi - lo) / kMaxQuantized).max(options_.resolution);
+    scale = (scale > 0.0f).select(scale, 1.0f);
+
+    // Quantize; points with any non-finite coordinate become kInvalid.
+    // Non-finite coordinates are masked before the cast, which is undefined
+    // for NaN and infinities.
+    quantized_.resize(3, num_points);
+    quantized_ =
+        finite.colwise()
+            .all()
+            .replicate<3, 1>()
+            .select(((finite.select(xyzs, 0.0f).colwise() - lo).colwise() /
+                     scale)
+                        .round()
+                        .max(0.0f)
+                        .min(kMaxQuantized),
+                    static_cast<float>(kInvalid))
+            .cast<std::uint16_t>();
+
+    const bool with_rgbs = cloud.has_rgbs() && !options_.drop_rgbs;
+    for (int axis = 0; axis < 3; ++axis) {
+      message->origin[axis] = lo[axis];
+      message->scale[axis] = scale[axis];
+    }
+    message->num_points = num_points;
+    message->flags = with_rgbs ? CompactPointCloud::FLAG_HAS_RGBS : 0;
+    message->chunk_size = options_.chunk_size;
+
+    // Worst case: every chunk raw, plus colors.
+    const int num_chunks =
+        (num_points + options_.chunk_size - 1) / options_.chunk_size;
+    std::vector<std::uint8_t>& data = message->data;
+    data.resize(num_chunks + 6 * std::size_t(num_points) +
+                (with_rgbs ? 3 * std::size_t(num_points) : 0));
+    std::uint8_t* out = data.data();
+
+    for (int start = 0; start < num_points; start += options_.chunk_size) {
+      const int count = std::min(options_.chunk_size, num_points - start);
+      const auto chunk = quantized_.middleCols(start, count);
+      bool delta = false;
+      if (count > 1) {
+        differences_ = chunk.rightCols(count - 1).cast<int>() -
+                       chunk.leftCols(count - 1).cast<int>();
+        delta = differences_.abs().maxCoeff() <= 127;
+      }
+      if (delta) {
+        *out++ = CompactPointCloud::CHUNK_DELTA;
+        for (int axis = 0; axis < 3; ++axis)
+          out = WriteU16(chunk(axis, 0), out);
+        for (int i = 0; i < count - 1; ++i) {
+          for (int axis = 0; axis < 3; ++axis)
+            *out++ = static_cast<std::uint8_t>(
+                static_cast<std::int8_t>(differences_(axis, i)));
+        }
+      } else {
+        *out++ = CompactPointCloud::CHUNK_RAW;
+        for (int i = 0; i < count; ++i) {
+          for (int axis = 0; axis < 3; ++axis)
+            out = WriteU16(chunk(axis, i), out);
+        }
+      }
+    }
+    if (with_rgbs) {
+      // Matrix3X<uint8_t> is column-major, i.e. already rgbrgb...
+      std::memcpy(out, cloud.rgbs().data(), 3 * std::size_t(num_points));
+      out += 3 * std::size_t(num_points);
+    }
+    data.resize(out - data.data());
+  }
+
+ private:
+  static std::uint8_t* WriteU16(std::uint16_t value, std::uint8_t* out) {
+    out[0] = static_cast<std::uint8_t>(value & 0xff);
+    out[1] = static_cast<std::uint8_t>(value >> 8);
+    return out + 2;
+  }
+
+  const CompactPointCloudOptions options_;
+
+  Eigen::Array<std::uint16_t, 3, Eigen::Dynamic> quantized_;
+  Eigen::Array<int, 3, Eigen::Dynamic> differences_;
+};
+
+/**
+ * Decodes a CompactPointCloud message written by CompactPointCloudEncoder
+ * into @p cloud, reusing its storage when the size and fields match. Returns
+ * false, leaving @p cloud unspecified, if the message is malformed.
+ */
+inline bool DecodeCompactPointCloud(const CompactPointCloud& message,
+                                    perception::PointCloud* cloud) {
+  DRAKE_DEMAND(cloud != nullptr);
+  const bool with_rgbs = message.flags & CompactPointCloud::FLAG_HAS_RGBS;
+  const int chunk_size = message.chunk_size;
+  if (chunk_size < 1) return false;
+
+  // num_points comes off the wire: check that data can hold that many points
+  // before allocating anything for them. Every chunk takes at least a mode
+  // byte and 3 bytes more than 3 per point (delta packing), every color 3.
+  const std::uint64_t claimed_points = message.num_points;
+  const std::uint64_t claimed_chunks =
+      (claimed_points + chunk_size - 1) / chunk_size;
+  if (claimed_points > std::uint64_t(std::numeric_limits<int>::max()) ||
+      message.data.size() <
+          4 * claimed_chunks + (with_rgbs ? 6 : 3) * claimed_points) {
+    return false;
+  }
+  const int num_points = static_cast<int>(claimed_points);
+
+  const perception::pc_flags::Fields fields =
+      with_rgbs ? perception::pc_flags::kXYZs | perception::pc_flags::kRGBs
+                : perception::pc_flags::Fields(perception::pc_flags::kXYZs);
+  if (cloud->size() != num_points || cloud->fields() != fields)
+    *cloud = perception::PointCloud(num_points, fields);
+
+  const std::uint8_t* in = message.data.data();
+  const std::uint8_t* const end = in + message.data.size();
+
+  // Decode into quantized coordinates first, then dequantize in one batch.
+  // The little-endian uint16 are read through strided maps of their low and
+  // high bytes.
+  using Bytes = Eigen::Map<const Eigen::Array<std::uint8_t, 3, Eigen::Dynamic>,
+                           0, Eigen::Stride<6, 2>>;
+  using Deltas = Eigen::Map<const Eigen::Array<std::int8_t, 3, Eigen::Dynamic>>;
+  Eigen::Array<float, 3, Eigen::Dynamic> quantized(3, num_points);
+  for (int start = 0; start < num_points; start += chunk_size) {
+    const int count = std::min(chunk_size, num_points - start);
+    if (in == end) return false;
+    const std::uint8_t mode = *in++;
+    if (mode == CompactPointCloud::CHUNK_DELTA) {
+      if (end - in < 6 + 3 * std::ptrdiff_t(count - 1)) return false;
+      quantized.col(start) = Bytes(in, 3, 1).cast<float>() +
+                             256.0f * Bytes(in + 1, 3, 1).cast<float>();
+      in += 6;
+      // The running sum is inherently sequential, but each step is one
+      // 3-vector addition.
+      const Deltas deltas(reinterpret_cast<const std::int8_t*>(in), 3,
+                          count - 1);
+      for (int i = 1; i < count; ++i) {
+        quantized.col(start + i) =
+            quantized.col(start + i - 1) + deltas.col(i - 1).cast<float>();
+      }
+      in += 3 * std::ptrdiff_t(count - 1);
+    } else if (mode == CompactPointCloud::CHUNK_RAW) {
+      if (end - in < 6 * std::ptrdiff_t(count)) return false;
+      quantized.middleCols(start, count) =
+          Bytes(in, 3, count).cast<float>() +
+          256.0f * Bytes(in + 1, 3, count).cast<float>();
+      in += 6 * std::ptrdiff_t(count);
+    } else {
+      return false;
+    }
+  }
+
+  const Eigen::Array3f origin(message.origin[0], message.origin[1],
+                              message.origin[2]);
+  const Eigen::Array3f scale(message.scale[0], message.scale[1],
+                             message.scale[2]);
+  const float kNaN = std::numeric_limits<float>::quiet_NaN();
+  cloud->mutable_xyzs() =
+      (quantized == 65535.0f)
+          .select(kNaN, (quantized.colwise() * scale).colwise() + origin)
+          .matrix();
+
+  if (with_rgbs) {
+    if (end - in < 3 * std::ptrdiff_t(num_points)) return false;
+    std::memcpy(cloud->mutable_rgbs().data(), in, 3 * std::size_t(num_points));
+  }
+  return true;
+}
+
+}  // namespace drake_ros_systems
@@ -0,0 +1,176 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include <lz4.h>
+#include <lz4hc.h>
+#include <zstd.h>
+
+#include "drake/common/drake_assert.h"
+#include "drake/common/drake_copyable.h"
+
+#include "drake_ros_systems/CompressedMessage.h"
+
+namespace drake_ros_systems {
+
+/**
+ * Returns the highest compression level of @p codec, a
+ * CompressedMessage::CODEC_* constant. Levels start at 1, the fastest.
+ *
+ * For CODEC_LZ4, level 1 is LZ4's default fast mode and levels 2 to 12 are
+ * the matching LZ4HC levels. For CODEC_ZSTD, levels 1 to 19 are the zstd
+ * levels of the same number; the slower "ultra" levels are left out.
+ */
+inline int GetMaxCompressionLevel(uint8_t codec) {
+  switch (codec) {
+    case CompressedMessage::CODEC_LZ4:
+      return LZ4HC_CLEVEL_MAX;
+    case CompressedMessage::CODEC_ZSTD:
+      return 19;
+    default:
+      return 1;
+  }
+}
+
+/**
+ * Compresses serialized messages into the data of CompressedMessage
+ * envelopes. The compressor keeps its zstd context and scratch buffer between
+ * calls, so an instance should be reused for every message of a stream, from
+ * one thread at a time.
+ */
+class MessageCompressor {
+ public:
+  DRAKE_NO_COPY_NO_MOVE_NO_ASSIGN(MessageCompressor)
+
+  explicit MessageCompressor(uint8_t codec) : codec_(codec) {
+    DRAKE_DEMAND(codec_ == CompressedMessage::CODEC_NONE ||
+                 codec_ == CompressedMessage::CODEC_LZ4 ||
+                 codec_ == CompressedMessage::CODEC_ZSTD);
+    if (codec_ == CompressedMessage::CODEC_ZSTD)
+      zstd_context_ = ZSTD_createCCtx();
+  }
+
+  ~MessageCompressor() {
+    if (zstd_context_ != nullptr) ZSTD_freeCCtx(zstd_context_);
+  }
+
+  uint8_t get_codec() const { return codec_; }
+
+  /**
+   * Fills `codec`, `level`, `uncompressed_size` and `data` of @p envelope
+   * from the serialized message @p bytes, compressed at @p level. Bytes that
+   * do not get smaller are stored uncompressed.
+   */
+  void Compress(const std::vector<uint8_t>& bytes, int level,
+                CompressedMessage* envelope) {
+    DRAKE_DEMAND(level >= 1 && level <= GetMaxCompressionLevel(codec_));
+    const int size = static_cast<int>(bytes.size());
+    int compressed_size = 0;
+    if (codec_ == CompressedMessage::CODEC_LZ4) {
+      scratch_.resize(LZ4_compressBound(size));
+      const char* src = reinterpret_cast<const char*>(bytes.data());
+      char* dst = reinterpret_cast<char*>(scratch_.data());
+      compressed_size =
+          level == 1 ? LZ4_compress_default(src, dst, size, scratch_.size())
+                     : LZ4_compress_HC(src, dst, size, scratch_.size(), level);
+    } else if (codec_ == CompressedMessage::CODEC_ZSTD) {
+      scratch_.resize(ZSTD_compressBound(size));
+      const std::size_t result =
+          ZSTD_compressCCtx(zstd_context_, scratch_.data(), scratch_.size(),
+                            bytes.data(), size, level);
+      if (!ZSTD_isError(result)) compressed_size = static_cast<int>(result);
+    }
+
+    envelope->uncompressed_size = size;
+    if (compressed_size > 0 && compressed_size < size) {
+      envelope->codec = codec_;
+      envelope->level = level;
+      envelope->data.assign(scratch_.begin(),
+                            scratch_.begin() + compressed_size);
+    } else {
+      envelope->codec = CompressedMessage::CODEC_NONE;
+      envelope->level = 0;
+      envelope->data = bytes;
+    }
+  }
+
+ private:
+  const uint8_t codec_;
+  ZSTD_CCtx* zstd_context_{};
+  std::vector<uint8_t> scratch_;
+};
+
+/**
+ * Restores the serialized message of CompressedMessage envelopes written by
+ * MessageCompressor, whatever their codec. Like the compressor, an instance
+ * should be reused from one thread at a time.
+ *
+ * The uncompressed size comes off the wire, so it is checked against the
+ * compressed data and @p max_uncompressed_size before anything is allocated.
+ */
+class MessageDecompressor {
+ public:
+  DRAKE_NO_COPY_NO_MOVE_NO_ASSIGN(MessageDecompressor)
+
+  /// The default largest accepted message, 256 MiB.
+  static constexpr std::size_t kDefaultMaxUncompressedSize = 256u << 20;
+
+  explicit MessageDecompressor(
+      std::size_t max_uncompressed_size = kDefaultMaxUncompressedSize)
+      : max_uncompressed_size_(max_uncompressed_size),
+        zstd_context_(ZSTD_createDCtx()) {}
+
+  ~MessageDecompressor() { ZSTD_freeDCtx(zstd_context_); }
+
+  std::size_t get_max_uncompressed_size() const {
+    return max_uncompressed_size_;
+  }
+
+  /**
+   * Writes the serialized message of @p envelope into @p bytes. Returns
+   * false if the envelope is malformed, uses an unknown codec or is larger
+   * than the cap.
+   */
+  bool Decompress(const CompressedMessage& envelope,
+                  std::vector<uint8_t>* bytes) {
+    const std::size_t size = envelope.uncompressed_size;
+    const std::size_t compressed_size = envelope.data.size();
+    if (size > max_uncompressed_size_) return false;
+    switch (envelope.codec) {
+      case CompressedMessage::CODEC_NONE:
+        if (compressed_size != size) return false;
+        bytes->assign(envelope.data.begin(), envelope.data.end());
+        return true;
+      case CompressedMessage::CODEC_LZ4:
+        // LZ4 cannot compress by more than a factor of 255.
+        if (size > 255 * compressed_size) return false;
+        bytes->resize(size);
+        return LZ4_decompress_safe(
+                   reinterpret_cast<const char*>(envelope.data.data()),
+                   reinterpret_cast<char*>(bytes->data()), compressed_size,
+                   size) == static_cast<int>(size);
+      case CompressedMessage::CODEC_ZSTD:
+        // MessageCompressor's frames record their content size.
+        if (ZSTD_getFrameContentSize(envelope.data.data(), compressed_size) !=
+            size) {
+          return false;
+        }
+        bytes->resize(size);
+        return ZSTD_decompressDCtx(zstd_context_, bytes->data(), size,
+                                   envelope.data.data(),
+                                   compressed_size) == size;
+      default:
+        return false;
+    }
+  }
+
+ private:
+  const std::size_t max_uncompressed_size_;
+  ZSTD_DCtx* const zstd_context_;
+};
+
+}  // namespace drake_ros_systems
@@ -0,0 +1,484 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <Eigen/Core>
+
+#include "drake/common/drake_assert.h"
+#include "drake/common/drake_copyable.h"
+#include "drake/systems/framework/context.h"
+
+#include "ros/serialization.h"
+
+#include "drake_ros_systems/subscriber_system_base.h"
+
+namespace drake_ros_systems {
+
+using namespace drake;
+
+/**
+ * Saves a Context, together with the receive buffers of the subscriber
+ * systems in it, into a compact binary snapshot and restores it, e.g. to
+ * resume a long simulation after a crash or to branch variant experiments
+ * off an interesting state.
+ *
+ * A snapshot holds the time, the continuous and discrete state, the numeric
+ * parameters and every abstract state value, each as raw doubles or
+ * through the serializer registered for its type. ints (such as the
+ * subscribers' message counters) and doubles are registered by default;
+ * ROS messages are added with RegisterRosMessage(), anything else with
+ * RegisterType(). Each subscriber added with AddSubscriber() also saves its
+ * receive buffer and counter, so that after a restore it schedules exactly
+ * the updates it would have scheduled at checkpoint time.
+ *
+ * Numbers are stored in the host's byte order, so a snapshot can only be
+ * restored on a host of the same byte order; others reject it.
+ *
+ * State that systems keep outside the Context is not part of a snapshot
+ * unless it is added with AddExternalState(). That includes the last
+ * message of a latched RosPublisherSystem, the newest stamps of a
+ * StaleMessageFilter and the messages a NetworkImpairment holds back.
+ * Without it, such systems carry on from where they were before the
+ * restore rather than from the checkpoint, e.g. a filter drops messages
+ * stamped after the checkpoint but before the restore.
+ *
+ * Restore() validates the whole snapshot against the Context before
+ * changing anything, and must be given a Context of the same System that
+ * the snapshot was taken from. Call Simulator::Initialize() after restoring
+ * into a simulator's Context. Messages that arrive while Restore() runs may
+ * be overwritten by the restored receive buffers.
+ */
+class ContextCheckpointer {
+ public:
+  DRAKE_NO_COPY_NO_MOVE_NO_ASSIGN(ContextCheckpointer)
+
+  ContextCheckpointer() {
+    RegisterPod<int>();
+    RegisterPod<double>();
+  }
+
+  /**
+   * Registers the serialization of abstract values of type T. @p load
+   * receives the bytes written by @p save and returns false if they are
+   * malformed.
+   */
+  template <typename T>
+  void RegisterType(
+      std::function<void(const T&, std::vector<std::uint8_t>*)> save,
+      std::function<bool(const std::uint8_t*, std::size_t, T*)> load) {
+    TypeSerializer serializer;
+    serializer.get = [](const systems::AbstractValue& value) -> const void* {
+      const auto* typed = dynamic_cast<const systems::Value<T>*>(&value);
+      return typed ? &typed->get_value() : nullptr;
+    };
+    serializer.get_mutable = [](systems::AbstractValue* value) -> void* {
+      auto* typed = dynamic_cast<systems::Value<T>*>(value);
+      return typed ? &typed->get_mutable_value() : nullptr;
+    };
+    serializer.save = [save](const void* value,
+                             std::vector<std::uint8_t>* out) {
+      save(*static_cast<const T*>(value), out);
+    };
+    serializer.load = [load](const std::uint8_t* data, std::size_t size,
+                             void* value) {
+      return load(data, size, static_cast<T*>(value));
+    };
+    serializers_.push_back(std::move(serializer));
+  }
+
+  /// Registers the ROS message type @p RosMessage, serialized with
+  /// ros::serialization.
+  template <typename RosMessage>
+  void RegisterRosMessage() {
+    RegisterType<RosMessage>(
+        [](const RosMessage& message, std::vector<std::uint8_t>* out) {
+          const std::uint32_t size =
+              ros::serialization::serializationLength(message);
+          out->resize(size);
+          ros::serialization::OStream stream(out->data(), size);
+          ros::serialization::serialize(stream, message);
+        },
+        [](const std::uint8_t* data, std::size_t size, RosMessage* message) {
+          try {
+            ros::serialization::IStream stream(
+                const_cast<std::uint8_t*>(data), size);
+            ros::serialization::deserialize(stream, *message);
+          } catch (const ros::serialization::StreamOverrunException&) {
+            return false;
+          }
+          return true;
+        });
+  }
+
+  /**
+   * Includes the receive buffer of @p subscriber in every snapshot. Its value
+   * type must be registered. @p subscriber must outlive this checkpointer.
+   */
+  template <typename T>
+  void AddSubscriber(SubscriberSystemBase<T>* subscriber) {
+    DRAKE_DEMAND(subscriber != nullptr);
+    const int type_index = FindSerializer<T>();
+    DRAKE_DEMAND(type_index >= 0);
+    ExternalEntry entry;
+    entry.save = [this, subscriber,
+                  type_index](std::vector<std::uint8_t>* out) {
+      T message{};
+      const std::int32_t count = subscriber->GetReceivedMessage(&message);
+      AppendPod(count, out);
+      AppendBlock(serializers_[type_index], &message, out);
+    };
+    entry.load = [this, subscriber, type_index](
+                     Reader* in, std::function<void()>* commit) {
+      const TypeSerializer& serializer = serializers_[type_index];
+      std::int32_t count{};
+      const std::uint8_t* data{};
+      std::uint32_t size{};
+      auto message = std::make_shared<T>();
+      if (!in->ReadPod(&count) || !in->ReadBlock(&data, &size) ||
+          !serializer.load(data, size, message.get())) {
+        return false;
+      }
+      *commit = [subscriber, message, count]() {
+        subscriber->SetReceivedMessage(*message, count);
+      };
+      return true;
+    };
+    subscribers_.push_back(std::move(entry));
+  }
+
+  /**
+   * Includes state kept outside the Context in every snapshot. @p save
+   * appends the state to its argument. @p load receives the bytes written by
+   * @p save and returns false if they are malformed; otherwise it sets its
+   * last argument to the function that applies them, which is only called
+   * once the whole snapshot is known to be valid.
+   */
+  void AddExternalState(
+      std::function<void(std::vector<std::uint8_t>*)> save,
+      std::function<bool(const std::uint8_t*, std::size_t,
+                         std::function<void()>*)>
+          load) {
+    DRAKE_DEMAND(save != nullptr && load != nullptr);
+    ExternalEntry entry;
+    entry.save = [save](std::vector<std::uint8_t>* out) {
+      std::vector<std::uint8_t> block;
+      save(&block);
+      AppendPod(static_cast<std::uint32_t>(block.size()), out);
+      out->insert(out->end(), block.begin(), block.end());
+    };
+    entry.load = [load](Reader* in, std::function<void()>* commit) {
+      const std::uint8_t* data{};
+      std::uint32_t size{};
+      return in->ReadBlock(&data, &size) && load(data, size, commit);
+    };
+    externals_.push_back(std::move(entry));
+  }
+
+  /// Returns a snapshot of @p context, of the added subscribers and of the
+  /// added external state.
+  std::vector<std::uint8_t> Save(
+      const systems::Context<double>& context) const {
+    DRAKE_DEMAND(context.num_abstract_parameters() == 0);
+    std::vector<std::uint8_t> out;
+    AppendPod(kMagic, &out);
+    AppendPod(kVersion, &out);
+    AppendPod(context.get_time(), &out);
+
+    AppendVector(context.get_continuous_state().CopyToVector(), &out);
+
+    const systems::DiscreteValues<double>& discrete =
+        context.get_discrete_state();
+    AppendPod(static_cast<std::uint32_t>(discrete.num_groups()), &out);
+    for (int i = 0; i < discrete.num_groups(); ++i)
+      AppendVector(discrete.get_vector(i).get_value(), &out);
+
+    AppendPod(static_cast<std::uint32_t>(context.num_numeric_parameters()),
+              &out);
+    for (int i = 0; i < context.num_numeric_parameters(); ++i)
+      AppendVector(context.get_numeric_parameter(i).get_value(), &out);
+
+    const systems::AbstractValues& abstract = context.get_abstract_state();
+    AppendPod(static_cast<std::uint32_t>(abstract.size()), &out);
+    for (int i = 0; i < abstract.size(); ++i) {
+      const systems::AbstractValue& value = abstract.get_value(i);
+      std::uint16_t type_index = 0;
+      const void* typed = nullptr;
+      for (; type_index < serializers_.size(); ++type_index) {
+        typed = serializers_[type_index].get(value);
+        if (typed != nullptr) break;
+      }
+      // Every abstract state type must be registered.
+      DRAKE_DEMAND(typed != nullptr);
+      AppendPod(type_index, &out);
+      AppendBlock(serializers_[type_index], typed, &out);
+    }
+
+    AppendPod(static_cast<std::uint32_t>(subscribers_.size()), &out);
+    for (const ExternalEntry& subscriber : subscribers_)
+      subscriber.save(&out);
+
+    AppendPod(static_cast<std::uint32_t>(externals_.size()), &out);
+    for (const ExternalEntry& external : externals_) external.save(&out);
+    return out;
+  }
+
+  /**
+   * Restores @p context, the added subscribers and the added external state
+   * from @p snapshot. Returns false, leaving them all untouched, if the
+   * snapshot is malformed or does not match them.
+   */
+  bool Restore(const std::vector<std::uint8_t>& snapshot,
+               systems::Context<double>* context) const {
+    DRAKE_DEMAND(context != nullptr);
+    Reader in{snapshot.data(), snapshot.data() + snapshot.size()};
+    std::uint32_t magic{}, version{};
+    double time{};
+    if (!in.ReadPod(&magic) || magic != kMagic || !in.ReadPod(&version) ||
+        version != kVersion || !in.ReadPod(&time)) {
+      return false;
+    }
+
+    Eigen::VectorXd continuous;
+    if (!in.ReadVector(&continuous) ||
+        continuous.size() != context->get_continuous_state().size()) {
+      return false;
+    }
+
+    const systems::DiscreteValues<double>& discrete =
+        context->get_discrete_state();
+    std::vector<Eigen::VectorXd> groups;
+    if (!ReadVectors(&in, &groups) ||
+        static_cast<int>(groups.size()) != discrete.num_groups()) {
+      return false;
+    }
+    for (int i = 0; i < discrete.num_groups(); ++i) {
+      if (groups[i].size() != discrete.get_vector(i).size()) return false;
+    }
+
+    std::vector<Eigen::VectorXd> parameters;
+    if (!ReadVectors(&in, &parameters) ||
+        static_cast<int>(parameters.size()) !=
+            context->num_numeric_parameters()) {
+      return false;
+    }
+    for (int i = 0; i < context->num_numeric_parameters(); ++i) {
+      if (parameters[i].size() != context->get_numeric_parameter(i).size())
+        return false;
+    }
+
+    // Abstract values are decoded into clones first, so that nothing is
+    // changed unless the whole snapshot is valid.
+    const systems::AbstractValues& abstract = context->get_abstract_state();
+    std::uint32_t num_abstract{};
+    if (!in.ReadPod(&num_abstract) ||
+        static_cast<int>(num_abstract) != abstract.size()) {
+      return false;
+    }
+    std::vector<std::unique_ptr<systems::AbstractValue>> values;
+    values.reserve(num_abstract);
+    for (int i = 0; i < abstract.size(); ++i) {
+      std::uint16_t type_index{};
+      const std::uint8_t* data{};
+      std::uint32_t size{};
+      if (!in.ReadPod(&type_index) || type_index >= serializers_.size() ||
+          !in.ReadBlock(&data, &size)) {
+        return false;
+      }
+      const TypeSerializer& serializer = serializers_[type_index];
+      std::unique_ptr<systems::AbstractValue> value =
+          abstract.get_value(i).Clone();
+      void* typed = serializer.get_mutable(value.get());
+      if (typed == nullptr || !serializer.load(data, size, typed))
+        return false;
+      values.push_back(std::move(value));
+    }
+
+    std::uint32_t num_subscribers{};
+    if (!in.ReadPod(&num_subscribers) ||
+        num_subscribers != subscribers_.size()) {
+      return false;
+    }
+    std::vector<std::function<void()>> commits(num_subscribers);
+    for (std::size_t i = 0; i < subscribers_.size(); ++i) {
+      if (!subscribers_[i].load(&in, &commits[i])) return false;
+    }
+    std::uint32_t num_externals{};
+    if (!in.ReadPod(&num_externals) || num_externals != externals_.size())
+      return false;
+    commits.resize(num_subscribers + num_externals);
+    for (std::size_t i = 0; i < externals_.size(); ++i) {
+      if (!externals_[i].load(&in, &commits[num_subscribers + i]))
+        return false;
+    }
+    if (in.data != in.end) return false;
+
+    context->set_time(time);
+    context->get_mutable_continuous_state().SetFromVector(continuous);
+    for (int i = 0; i < discrete.num_groups(); ++i) {
+      context->get_mutable_discrete_state().get_mutable_vector(i)
+          .SetFromVector(groups[i]);
+    }
+    for (int i = 0; i < context->num_numeric_parameters(); ++i)
+      context->get_mutable_numeric_parameter(i).SetFromVector(parameters[i]);
+    for (int i = 0; i < abstract.size(); ++i)
+      context->get_mutable_abstract_state().get_mutable_value(i).SetFrom(
+          *values[i]);
+    for (const std::function<void()>& commit : commits) commit();
+    return true;
+  }
+
+  /// Writes Save(@p context) to @p filename. Returns false on I/O errors.
+  bool SaveToFile(const std::string& filename,
+                  const systems::Context<double>& context) const {
+    const std::vector<std::uint8_t> snapshot = Save(context);
+    std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+    file.write(reinterpret_cast<const char*>(snapshot.data()),
+               snapshot.size());
+    return static_cast<bool>(file);
+  }
+
+  /// Restores from a snapshot written by SaveToFile(). Returns false on I/O
+  /// errors or if Restore() fails.
+  bool RestoreFromFile(const std::string& filename,
+                       systems::Context<double>* context) const {
+    std::ifstream file(filename, std::ios::binary);
+    if (!file) return false;
+    const std::vector<std::uint8_t> snapshot(
+        (std::istreambuf_iterator<char>(file)),
+        std::istreambuf_iterator<char>());
+    return Restore(snapshot, context);
+  }
+
+ private:
+  // Reads "DRCK" on little-endian hosts, so that snapshots of a host of the
+  // other byte order are rejected.
+  static constexpr std::uint32_t kMagic = 0x4b435244;
+  static constexpr std::uint32_t kVersion = 2;
+
+  struct TypeSerializer {
+    // Return the typed value, or nullptr if it is of another type.
+    std::function<const void*(const systems::AbstractValue&)> get;
+    std::function<void*(systems::AbstractValue*)> get_mutable;
+    std::function<void(const void*, std::vector<std::uint8_t>*)> save;
+    std::function<bool(const std::uint8_t*, std::size_t, void*)> load;
+  };
+
+  struct Reader {
+    template <typename Pod>
+    bool ReadPod(Pod* value) {
+      if (static_cast<std::size_t>(end - data) < sizeof(Pod)) return false;
+      std::memcpy(value, data, sizeof(Pod));
+      data += sizeof(Pod);
+      return true;
+    }
+
+    bool ReadBlock(const std::uint8_t** block, std::uint32_t* size) {
+      if (!ReadPod(size) || static_cast<std::size_t>(end - data) < *size)
+        return false;
+      *block = data;
+      data += *size;
+      return true;
+    }
+
+    bool ReadVector(Eigen::VectorXd* vector) {
+      std::uint32_t size{};
+      if (!ReadPod(&size) ||
+          static_cast<std::size_t>(end - data) / sizeof(double) < size) {
+        return false;
+      }
+      vector->resize(size);
+      std::memcpy(vector->data(), data, size * sizeof(double));
+      data += size * sizeof(double);
+      return true;
+    }
+
+    const std::uint8_t* data;
+    const std::uint8_t* const end;
+  };
+
+  // A subscriber's receive buffer or other state kept outside the Context.
+  struct ExternalEntry {
+    std::function<void(std::vector<std::uint8_t>*)> save;
+    // Validates the next entry of the snapshot and sets the function that
+    // applies it.
+    std::function<bool(Reader*, std::function<void()>*)> load;
+  };
+
+  template <typename Pod>
+  void RegisterPod() {
+    static_assert(std::is_trivially_copyable<Pod>::value, "");
+    RegisterType<Pod>(
+        [](const Pod& value, std::vector<std::uint8_t>* out) {
+          out->resize(sizeof(Pod));
+          std::memcpy(out->data(), &value, sizeof(Pod));
+        },
+        [](const std::uint8_t* data, std::size_t size, Pod* value) {
+          if (size != sizeof(Pod)) return false;
+          std::memcpy(value, data, sizeof(Pod));
+          return true;
+        });
+  }
+
+  // Returns the index of the serializer of T, or -1.
+  template <typename T>
+  int FindSerializer() const {
+    const systems::Value<T> probe{T{}};
+    for (std::size_t i = 0; i < serializers_.size(); ++i) {
+      if (serializers_[i].get(probe) != nullptr) return static_cast<int>(i);
+    }
+    return -1;
+  }
+
+  template <typename Pod>
+  static void AppendPod(Pod value, std::vector<std::uint8_t>* out) {
+    const auto* bytes = reinterpret_cast<const std::uint8_t*>(&value);
+    out->insert(out->end(), bytes, bytes + sizeof(Pod));
+  }
+
+  static void AppendVector(const Eigen::VectorXd& vector,
+                           std::vector<std::uint8_t>* out) {
+    AppendPod(static_cast<std::uint32_t>(vector.size()), out);
+    const auto* bytes = reinterpret_cast<const std::uint8_t*>(vector.data());
+    out->insert(out->end(), bytes, bytes + vector.size() * sizeof(double));
+  }
+
+  static void AppendBlock(const TypeSerializer& serializer, const void* value,
+                          std::vector<std::uint8_t>* out) {
+    std::vector<std::uint8_t> block;
+    serializer.save(value, &block);
+    AppendPod(static_cast<std::uint32_t>(block.size()), out);
+    out->insert(out->end(), block.begin(), block.end());
+  }
+
+  static bool ReadVectors(Reader* in, std::vector<Eigen::VectorXd>* vectors) {
+    std::uint32_t count{};
+    // Every vector takes at least its 4-byte size.
+    if (!in->ReadPod(&count) ||
+        static_cast<std::size_t>(in->end - in->data) / 4 < count) {
+      return false;
+    }
+    vectors->resize(count);
+    for (Eigen::VectorXd& vector : *vectors) {
+      if (!in->ReadVector(&vector)) return false;
+    }
+    return true;
+  }
+
+  // Tried in order; a type must not be registered twice.
+  std::vector<TypeSerializer> serializers_;
+
+  std::vector<ExternalEntry> subscribers_;
+  std::vector<ExternalEntry> externals_;
+};
+
+}  // namespace drake_ros_systems
@@ -0,0 +1,334 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <limits>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "boost/bind.hpp"
+
+#include "drake/common/drake_copyable.h"
+#include "drake/systems/analysis/simulator.h"
+
+#include "ros/callback_queue.h"
+#include "ros/ros.h"
+#include "ros/topic_manager.h"
+
+#include "drake_ros_systems/CoSimulationTime.h"
+#include "drake_ros_systems/ros_publisher_system.h"
+
+namespace drake_ros_systems {
+
+using namespace drake;
+
+/**
+ * Advances a Simulator in lockstep with simulators running in other
+ * processes, using a conservative time barrier over ROS, such that repeated
+ * runs exchange the same messages at the same simulation times.
+ *
+ * Simulation time is cut into windows of `lookahead` seconds, starting at the
+ * time of the first AdvanceTo() call, which must be the same for all
+ * participants, as must the lookahead. A participant simulates a window up to
+ * strictly below its end, so that events at the end belong to the next
+ * window, and then announces on `<ns>/<name>/time` the window end together
+ * with the number of messages it has published so far on each bridge topic
+ * registered with AddPublisher(). Before simulating a window, a participant
+ * waits for every peer to have announced the window's start, and delivers
+ * exactly the announced number of messages of each bridge topic it receives.
+ *
+ * Bridge subscribers must therefore be created on the node handle returned
+ * by GetSubscriberNodeHandle(): their callbacks are not spun by anyone but
+ * the barrier. Data and announcements still travel on separate connections,
+ * but data is never acted upon before the announcement that accounts for it,
+ * and never later: messages a peer publishes during a window are received
+ * at the start of the next window, whatever the wall-clock timing. The
+ * lookahead is thus the latency of the bridge; choosing the smallest publish
+ * period, see AddPublishPeriod(), delivers every message before the next one
+ * of the same topic is published. Within a window the simulator runs as fast
+ * as it can, with no wall-clock pacing.
+ *
+ * Bridge data topics are not latched, so a message published before the
+ * peer's subscriber connected would be lost and the count never reached.
+ * The first AdvanceTo() therefore announces nothing until every bridge
+ * publisher has a subscriber and every bridge subscription a publisher; as
+ * every participant does the same before announcing its start, no bridge
+ * message is published before all links are up.
+ *
+ * Every published message must arrive, so bridge systems must neither use a
+ * network impairment nor a stale message horizon, and subscriber queues
+ * must hold a window's worth of messages.
+ */
+class CoSimulationBarrier {
+ public:
+  DRAKE_NO_COPY_NO_MOVE_NO_ASSIGN(CoSimulationBarrier)
+
+  /**
+   * @param[in] name The name of this participant, unique among peers.
+   *
+   * @param[in] peers The names of all other participants.
+   *
+   * @param node_handle The ROS context. Its callbacks must be spun, e.g. by
+   * a ros::AsyncSpinner, for announcements from peers to arrive.
+   *
+   * @param[in] ns Namespace of the announcement topics.
+   */
+  CoSimulationBarrier(const std::string& name,
+                      const std::vector<std::string>& peers,
+                      ros::NodeHandle* node_handle,
+                      const std::string& ns = "cosim")
+      : name_(name), node_handle_(node_handle) {
+    DRAKE_DEMAND(node_handle_ != nullptr);
+    DRAKE_DEMAND(!peers.empty());
+
+    // Latched, so that late joiners still see where we are.
+    time_publisher_ = node_handle_->advertise<CoSimulationTime>(
+        ns + "/" + name_ + "/time", 1, true);
+
+    for (const std::string& peer : peers) {
+      DRAKE_DEMAND(peer != name_);
+      peer_times_[peer] = -std::numeric_limits<double>::infinity();
+      pending_announcements_[peer];
+    }
+    for (const std::string& peer : peers) {
+      peer_subscribers_.push_back(node_handle_->subscribe<CoSimulationTime>(
+          ns + "/" + peer + "/time", 10,
+          boost::bind(&CoSimulationBarrier::HandleAnnouncement, this, _1,
+                      peer)));
+    }
+  }
+
+  const std::string& get_name() const { return name_; }
+
+  /**
+   * Declares that a bridge publisher feeding a peer publishes every
+   * @p period seconds. The lookahead is the smallest declared period.
+   */
+  void AddPublishPeriod(double period) {
+    DRAKE_DEMAND(period > 0.0);
+    lookahead_ = std::min(lookahead_, period);
+  }
+
+  /// Returns the lookahead, i.e. the smallest declared publish period.
+  double get_lookahead() const { return lookahead_; }
+
+  /**
+   * Registers a bridge publisher feeding a peer, so that announcements
+   * account for its messages. The peer must receive them on the node handle
+   * returned by its GetSubscriberNodeHandle() for the same topic name. Must
+   * be called before the first AdvanceTo().
+   */
+  template <typename RosMessage>
+  void AddPublisher(const RosPublisherSystem<RosMessage>& publisher) {
+    DRAKE_DEMAND(!started_);
+    Outbound outbound;
+    outbound.topic = publisher.get_topic_name();
+    outbound.published_message_count = [&publisher]() {
+      return publisher.get_published_message_count();
+    };
+    outbound.num_subscribers = [&publisher]() {
+      return publisher.get_num_subscribers();
+    };
+    outbound_.push_back(std::move(outbound));
+  }
+
+  /**
+   * Returns the node handle to create the bridge subscriber of @p topic, a
+   * topic published by a peer, on. Its callbacks are delivered by the
+   * barrier, see the class documentation. Must be called before the first
+   * AdvanceTo(), and the barrier must outlive the subscriber.
+   */
+  ros::NodeHandle* GetSubscriberNodeHandle(const std::string& topic) {
+    DRAKE_DEMAND(!started_);
+    Inbound& inbound = inbound_[topic];
+    if (!inbound.node_handle) {
+      inbound.queue = std::make_unique<ros::CallbackQueue>();
+      inbound.node_handle = std::make_unique<ros::NodeHandle>(*node_handle_);
+      inbound.node_handle->setCallbackQueue(inbound.queue.get());
+    }
+    return inbound.node_handle.get();
+  }
+
+  /// Returns the time up to which this participant may currently advance.
+  double GetSafeHorizon() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    double slowest_peer = std::numeric_limits<double>::infinity();
+    for (const auto& peer_time : peer_times_)
+      slowest_peer = std::min(slowest_peer, peer_time.second);
+    return slowest_peer + lookahead_;
+  }
+
+  /**
+   * Advances @p simulator to @p end_time, one window at a time. Disables
+   * real-time pacing on @p simulator. Returns false if ROS shut down before
+   * @p end_time was reached.
+   */
+  bool AdvanceTo(systems::Simulator<double>* simulator, double end_time) {
+    DRAKE_DEMAND(simulator != nullptr);
+    // At least one bridge publisher must have been declared, or there is no
+    // finite window to advance by.
+    DRAKE_DEMAND(lookahead_ < std::numeric_limits<double>::infinity());
+    simulator->set_target_realtime_rate(0.0);
+
+    if (!started_) {
+      if (!AwaitConnections()) return false;
+      started_ = true;
+      start_time_ = simulator->get_context().get_time();
+      Announce(start_time_);
+    }
+    while (simulator->get_context().get_time() < end_time) {
+      const double window_start = start_time_ + window_ * lookahead_;
+      const double window_end = start_time_ + (window_ + 1) * lookahead_;
+      if (!AwaitPeers(window_start)) return false;
+
+      const double last_time_of_window =
+          std::nextafter(window_end, -std::numeric_limits<double>::infinity());
+      simulator->StepTo(std::min(last_time_of_window, end_time));
+      // A window cut short by end_time is continued by the next call.
+      if (simulator->get_context().get_time() >= last_time_of_window) {
+        ++window_;
+        Announce(window_end);
+      }
+    }
+    return true;
+  }
+
+ private:
+  // A bridge topic published to a peer.
+  struct Outbound {
+    std::string topic;
+    std::function<int()> published_message_count;
+    std::function<int()> num_subscribers;
+  };
+
+  // A bridge topic received from a peer.
+  struct Inbound {
+    std::unique_ptr<ros::CallbackQueue> queue;
+    std::unique_ptr<ros::NodeHandle> node_handle;
+    // Messages handed over to the subscriber so far.
+    uint32_t delivered{0};
+  };
+
+  // Waits until every bridge publisher has a subscriber and every bridge
+  // subscription has a publisher. Returns false on ROS shutdown.
+  bool AwaitConnections() const {
+    while (true) {
+      bool connected = true;
+      for (const Outbound& outbound : outbound_)
+        connected &= outbound.num_subscribers() > 0;
+      for (const auto& topic_inbound : inbound_) {
+        const std::string topic =
+            topic_inbound.second.node_handle->resolveName(topic_inbound.first);
+        connected &= ros::TopicManager::instance()->getNumPublishers(topic) > 0;
+      }
+      if (connected) return true;
+      if (!ros::ok()) return false;
+      std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+  }
+
+  // Waits until every peer announced @p window_start, then delivers the
+  // messages they published before it. Returns false on ROS shutdown.
+  bool AwaitPeers(double window_start) {
+    std::vector<std::pair<Inbound*, uint32_t>> deliveries;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      for (auto& peer_pending : pending_announcements_) {
+        auto& pending = peer_pending.second;
+        while (true) {
+          // Earlier announcements are superseded, their counts being
+          // cumulative.
+          while (!pending.empty() && pending.front()->time < window_start)
+            pending.pop_front();
+          if (!pending.empty()) break;
+          if (!ros::ok()) return false;
+          // Wake up periodically to notice a ROS shutdown.
+          condition_variable_.wait_for(lock, std::chrono::milliseconds(100));
+        }
+        const CoSimulationTime& announcement = *pending.front();
+        peer_times_[peer_pending.first] = announcement.time;
+        for (std::size_t i = 0; i < announcement.topics.size() &&
+                                i < announcement.message_counts.size();
+             ++i) {
+          auto it = inbound_.find(announcement.topics[i]);
+          if (it != inbound_.end())
+            deliveries.emplace_back(&it->second,
+                                    announcement.message_counts[i]);
+        }
+      }
+    }
+
+    for (const auto& delivery : deliveries) {
+      Inbound& inbound = *delivery.first;
+      while (inbound.delivered < delivery.second) {
+        if (!ros::ok()) return false;
+        if (inbound.queue->callOne(ros::WallDuration(0.1)) ==
+            ros::CallbackQueue::Called) {
+          ++inbound.delivered;
+        }
+      }
+    }
+    return true;
+  }
+
+  void Announce(double time) {
+    announcement_.time = time;
+    announcement_.topics.clear();
+    announcement_.message_counts.clear();
+    for (const Outbound& outbound : outbound_) {
+      announcement_.topics.push_back(outbound.topic);
+      announcement_.message_counts.push_back(
+          outbound.published_message_count());
+    }
+    time_publisher_.publish(announcement_);
+  }
+
+  void HandleAnnouncement(const CoSimulationTime::ConstPtr& message,
+                          const std::string& peer) {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      pending_announcements_.at(peer).push_back(message);
+    }
+    condition_variable_.notify_all();
+  }
+
+  const std::string name_;
+  ros::NodeHandle* const node_handle_{};
+
+  double lookahead_{std::numeric_limits<double>::infinity()};
+
+  // Set by the first AdvanceTo().
+  bool started_{false};
+  double start_time_{0.0};
+  // The index of the window being simulated.
+  int window_{0};
+
+  std::vector<Outbound> outbound_;
+  // Bridge subscriptions, by topic.
+  std::map<std::string, Inbound> inbound_;
+  CoSimulationTime announcement_;
+
+  // The mutex that guards the two maps below.
+  mutable std::mutex mutex_;
+  std::condition_variable condition_variable_;
+
+  // Announcements not acted upon yet, and the last window start each peer
+  // was waited for, by peer.
+  std::map<std::string, std::deque<CoSimulationTime::ConstPtr>>
+      pending_announcements_;
+  std::map<std::string, double> peer_times_;
+
+  ros::Publisher time_publisher_;
+  std::vector<ros::Subscriber> peer_subscribers_;
+};
+
+}  // namespace drake_ros_systems
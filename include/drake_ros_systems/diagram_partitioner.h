@@ -0,0 +1,152 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "drake/common/drake_copyable.h"
+#include "drake/systems/framework/diagram.h"
+#include "drake/systems/framework/diagram_builder.h"
+
+#include "ros/ros.h"
+
+#include "drake_ros_systems/ros_publisher_system.h"
+#include "drake_ros_systems/ros_subscriber_system.h"
+
+namespace drake_ros_systems {
+
+using namespace drake;
+
+/**
+ * Builds one partition of a diagram that is split across several processes.
+ *
+ * Every process runs the same construction code against its own
+ * %DiagramPartitioner, which only differs by the partition it is building.
+ * Each system is added as a factory together with the partition that owns
+ * it, and connections are declared between the returned handles and port
+ * indices as they would be on a DiagramBuilder. Only the systems owned by
+ * this process's partition are constructed and end up in the diagram, and
+ * every connection that crosses a partition boundary is replaced by a
+ * RosPublisherSystem on the sending side and a RosSubscriberSystem on the
+ * receiving side, so the ports of every local system are wired exactly as in
+ * the unpartitioned diagram.
+ *
+ * Cut connections are carried on topics named
+ * `<topic_prefix>/connection_<k>`, where k counts the calls to the
+ * message-typed Connect() in declaration order. The topics therefore line up
+ * across processes as long as they all declare the same connections in the
+ * same order.
+ *
+ * Factories of systems owned by other partitions are never called, so
+ * systems that talk to ROS on their own, such as a RosPublisherSystem, only
+ * ever advertise or subscribe in the partition that runs them.
+ */
+class DiagramPartitioner {
+ public:
+  DRAKE_NO_COPY_NO_MOVE_NO_ASSIGN(DiagramPartitioner)
+
+  /**
+   * @param[in] partition The partition built by this process.
+   *
+   * @param node_handle The ROS context used by the generated bridges.
+   *
+   * @param[in] topic_prefix Namespace of the generated bridge topics.
+   */
+  DiagramPartitioner(int partition, ros::NodeHandle* node_handle,
+                     const std::string& topic_prefix = "partition")
+      : partition_(partition),
+        node_handle_(node_handle),
+        topic_prefix_(topic_prefix) {
+    DRAKE_DEMAND(node_handle_ != nullptr);
+  }
+
+  int get_partition() const { return partition_; }
+
+  /// A system added with AddSystem(). `system` is null unless the system is
+  /// owned by the local partition, in which case it stays valid for the
+  /// lifetime of the built diagram.
+  template <class S>
+  struct SystemHandle {
+    int partition;
+    S* system;
+  };
+
+  /**
+   * Adds the system returned by @p make, a callable returning a
+   * std::unique_ptr to a System, to @p partition. @p make is only called if
+   * @p partition is the local one.
+   */
+  template <class Factory>
+  SystemHandle<typename decltype(std::declval<Factory&>()())::element_type>
+  AddSystem(int partition, Factory make) {
+    using S = typename decltype(make())::element_type;
+    if (partition != partition_) return SystemHandle<S>{partition, nullptr};
+    return SystemHandle<S>{partition, builder_.AddSystem(make())};
+  }
+
+  /**
+   * Connects output @p src_port of @p src to input @p dest_port of @p dest,
+   * which must live in the same partition. Aborts if they do not, since an
+   * untyped connection cannot be bridged.
+   */
+  template <class Src, class Dest>
+  void Connect(const SystemHandle<Src>& src, int src_port,
+               const SystemHandle<Dest>& dest, int dest_port) {
+    DRAKE_DEMAND(src.partition == dest.partition);
+    if (src.partition == partition_) {
+      builder_.Connect(src.system->get_output_port(src_port),
+                       dest.system->get_input_port(dest_port));
+    }
+  }
+
+  /**
+   * Connects two abstract-valued ports carrying Value<RosMessage>, as the
+   * untyped Connect() does. When both ends live in different partitions, the
+   * connection is cut and bridged over ROS, with the sending side publishing
+   * every @p publish_period seconds.
+   */
+  template <typename RosMessage, class Src, class Dest>
+  void Connect(const SystemHandle<Src>& src, int src_port,
+               const SystemHandle<Dest>& dest, int dest_port,
+               double publish_period) {
+    const std::string topic =
+        topic_prefix_ + "/connection_" + std::to_string(num_typed_connections_);
+    ++num_typed_connections_;
+
+    if (src.partition == dest.partition) {
+      Connect(src, src_port, dest, dest_port);
+      return;
+    }
+    if (src.partition == partition_) {
+      auto publisher = builder_.AddSystem(
+          RosPublisherSystem<RosMessage>::Make(topic, node_handle_));
+      publisher->set_publish_period(publish_period);
+      builder_.Connect(src.system->get_output_port(src_port),
+                       publisher->get_input_port(0));
+    } else if (dest.partition == partition_) {
+      auto subscriber = builder_.AddSystem(
+          RosSubscriberSystem<RosMessage>::Make(topic, node_handle_));
+      builder_.Connect(subscriber->get_output_port(0),
+                       dest.system->get_input_port(dest_port));
+    }
+  }
+
+  /// Exposes the builder of the local partition, e.g. to export ports.
+  systems::DiagramBuilder<double>* get_mutable_builder() { return &builder_; }
+
+  /// Builds the diagram of the local partition. May only be called once.
+  std::unique_ptr<systems::Diagram<double>> Build() {
+    return builder_.Build();
+  }
+
+ private:
+  const int partition_;
+  ros::NodeHandle* const node_handle_{};
+  const std::string topic_prefix_;
+
+  systems::DiagramBuilder<double> builder_;
+
+  int num_typed_connections_{0};
+};
+
+}  // namespace drake_ros_systems
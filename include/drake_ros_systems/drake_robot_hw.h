@@ -0,0 +1,177 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include <Eigen/Core>
+
+#include "drake/common/drake_copyable.h"
+#include "drake/common/eigen_types.h"
+#include "drake/multibody/plant/multibody_plant.h"
+#include "drake/systems/framework/context.h"
+#include "drake/systems/framework/fixed_input_port_value.h"
+
+#include "hardware_interface/joint_command_interface.h"
+#include "hardware_interface/joint_state_interface.h"
+#include "hardware_interface/robot_hw.h"
+#include "ros/ros.h"
+
+namespace drake_ros_systems {
+
+using namespace drake;
+
+/**
+ * A ros_control hardware interface whose joints are the actuated joints of a
+ * multibody::MultibodyPlant, for running a controller_manager in the same
+ * process and thread as the simulation.
+ *
+ * Every single-degree-of-freedom joint with an actuator is exposed through a
+ * hardware_interface::JointStateInterface and a
+ * hardware_interface::EffortJointInterface, under the joint's name. read()
+ * copies positions and velocities straight out of the plant's Context, and
+ * write() copies the effort commands into values fixed on the actuation input
+ * port of every model instance that has actuators, so a control cycle
+ * involves no messages and no serialization. The reported effort is the
+ * command applied by the last write(). Plants with several actuated model
+ * instances, or with none, are supported.
+ *
+ * Neither the plant's actuation input port nor any per-instance one may be
+ * connected in the Diagram. A typical loop, at the controller rate:
+ *
+ * @code
+ * hw.read(time, period);
+ * controller_manager.update(time, period);
+ * hw.write(time, period);
+ * simulator.StepTo(simulator.get_context().get_time() + period.toSec());
+ * @endcode
+ */
+class DrakeRobotHW : public hardware_interface::RobotHW {
+ public:
+  DRAKE_NO_COPY_NO_MOVE_NO_ASSIGN(DrakeRobotHW)
+
+  /**
+   * @param[in] plant The finalized plant. Must outlive this object.
+   *
+   * @param plant_context The plant's Context, e.g. from
+   * Diagram::GetMutableSubsystemContext() on the simulator's Context. Must
+   * outlive this object.
+   */
+  DrakeRobotHW(const multibody::MultibodyPlant<double>& plant,
+               systems::Context<double>* plant_context)
+      : plant_(plant), plant_context_(plant_context) {
+    DRAKE_DEMAND(plant_context_ != nullptr);
+    DRAKE_DEMAND(plant_.is_finalized());
+
+    const int num_actuators = plant_.num_actuators();
+    actuation_ = Eigen::VectorXd::Zero(num_actuators);
+
+    // The plant-wide actuation input port throws unless exactly one model
+    // instance is actuated, so every actuated instance gets its own.
+    for (multibody::ModelInstanceIndex instance(0);
+         instance < plant_.num_model_instances(); ++instance) {
+      const int num_instance_actuators = plant_.num_actuated_dofs(instance);
+      if (num_instance_actuators == 0) continue;
+      systems::FixedInputPortValue* value = &plant_context_->FixInputPort(
+          plant_.get_actuation_input_port(instance).get_index(),
+          Eigen::VectorXd::Zero(num_instance_actuators));
+      actuation_inputs_.push_back(InstanceInput{instance, value});
+    }
+
+    for (multibody::JointActuatorIndex i(0); i < num_actuators; ++i) {
+      const multibody::JointActuator<double>& actuator =
+          plant_.get_joint_actuator(i);
+      const multibody::Joint<double>& joint = actuator.joint();
+      if (joint.num_positions() != 1 || joint.num_velocities() != 1) {
+        ROS_WARN("DrakeRobotHW: skipping multi-dof joint '%s'",
+                 joint.name().c_str());
+        continue;
+      }
+      joints_.push_back(JointInfo{joint.name(), joint.position_start(),
+                                  joint.velocity_start(), &actuator});
+    }
+
+    const std::size_t num_joints = joints_.size();
+    position_.assign(num_joints, 0.0);
+    velocity_.assign(num_joints, 0.0);
+    effort_.assign(num_joints, 0.0);
+    command_.assign(num_joints, 0.0);
+    // Registered only once all vectors have their final size, since the
+    // handles point into them.
+    for (std::size_t j = 0; j < num_joints; ++j) {
+      hardware_interface::JointStateHandle state_handle(
+          joints_[j].name, &position_[j], &velocity_[j], &effort_[j]);
+      state_interface_.registerHandle(state_handle);
+      effort_interface_.registerHandle(
+          hardware_interface::JointHandle(state_handle, &command_[j]));
+    }
+    registerInterface(&state_interface_);
+    registerInterface(&effort_interface_);
+  }
+
+  /// Copies the joint positions and velocities from the plant's Context.
+  void read(const ros::Time&, const ros::Duration&) override {
+    const auto q = plant_.GetPositions(*plant_context_);
+    const auto v = plant_.GetVelocities(*plant_context_);
+    for (std::size_t j = 0; j < joints_.size(); ++j) {
+      position_[j] = q[joints_[j].position_index];
+      velocity_[j] = v[joints_[j].velocity_index];
+    }
+  }
+
+  /// Applies the effort commands to the plant's actuation inputs.
+  void write(const ros::Time&, const ros::Duration&) override {
+    for (std::size_t j = 0; j < joints_.size(); ++j) {
+      joints_[j].actuator->set_actuation_vector(
+          Vector1<double>(command_[j]), &actuation_);
+      effort_[j] = command_[j];
+    }
+    // GetActuationFromArray() orders each slice the way the instance's port
+    // expects.
+    for (const InstanceInput& input : actuation_inputs_) {
+      input.value->GetMutableVectorData<double>()->SetFromVector(
+          plant_.GetActuationFromArray(input.instance, actuation_));
+    }
+  }
+
+  /// Returns the names of the exposed joints.
+  std::vector<std::string> get_joint_names() const {
+    std::vector<std::string> names;
+    for (const JointInfo& joint : joints_) names.push_back(joint.name);
+    return names;
+  }
+
+ private:
+  struct JointInfo {
+    std::string name;
+    int position_index;
+    int velocity_index;
+    const multibody::JointActuator<double>* actuator;
+  };
+
+  struct InstanceInput {
+    multibody::ModelInstanceIndex instance;
+    systems::FixedInputPortValue* value;
+  };
+
+  const multibody::MultibodyPlant<double>& plant_;
+  systems::Context<double>* const plant_context_{};
+
+  std::vector<JointInfo> joints_;
+
+  // The buffers ros_control handles point to, indexed like joints_.
+  std::vector<double> position_;
+  std::vector<double> velocity_;
+  std::vector<double> effort_;
+  std::vector<double> command_;
+
+  // The plant-wide actuation vector, indexed by actuator; actuators of
+  // skipped joints stay at zero.
+  Eigen::VectorXd actuation_;
+  // One per actuated model instance.
+  std::vector<InstanceInput> actuation_inputs_;
+
+  hardware_interface::JointStateInterface state_interface_;
+  hardware_interface::EffortJointInterface effort_interface_;
+};
+
+}  // namespace drake_ros_systems
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <thread>
+
+#include "drake/systems/analysis/simulator.h"
+#include "drake/systems/framework/diagram.h"
+#include "drake/systems/framework/diagram_builder.h"
+
+#include "nodelet/nodelet.h"
+#include "ros/ros.h"
+
+namespace drake_ros_systems {
+
+using namespace drake;
+
+/**
+ * Hosts a Drake diagram and its ROS bridge systems inside a nodelet manager.
+ *
+ * Derived classes only implement BuildDiagram(). The bridge systems created
+ * there share the manager's process with the neighbouring nodelets, so
+ * messages exchanged with them are passed as shared pointers instead of being
+ * serialized over a socket. The simulation loop runs on its own thread, which
+ * is started by onInit() and joined when the nodelet is unloaded.
+ *
+ * Private parameters:
+ *  - `~target_realtime_rate` (double, default 1.0): passed on to
+ *    Simulator::set_target_realtime_rate().
+ *  - `~step_duration` (double, default 0.1): simulation time advanced per
+ *    StepTo() call; bounds how long unloading waits for the loop to stop.
+ */
+class DrakeSimulatorNodelet : public nodelet::Nodelet {
+ public:
+  ~DrakeSimulatorNodelet() override {
+    running_ = false;
+    if (simulation_thread_.joinable()) simulation_thread_.join();
+  }
+
+ protected:
+  /**
+   * Adds the systems of the hosted diagram to @p builder. Bridge systems
+   * should be constructed with @p node_handle, which is serviced by the
+   * manager's multi-threaded callback queue.
+   */
+  virtual void BuildDiagram(systems::DiagramBuilder<double>* builder,
+                            ros::NodeHandle* node_handle) = 0;
+
+  /// Returns the simulator, or nullptr before onInit().
+  systems::Simulator<double>* get_mutable_simulator() {
+    return simulator_.get();
+  }
+
+ private:
+  void onInit() override {
+    ros::NodeHandle& private_node_handle = getPrivateNodeHandle();
+    double target_realtime_rate = 1.0;
+    private_node_handle.param("target_realtime_rate", target_realtime_rate,
+                              target_realtime_rate);
+    private_node_handle.param("step_duration", step_duration_,
+                              step_duration_);
+
+    systems::DiagramBuilder<double> builder;
+    BuildDiagram(&builder, &getMTNodeHandle());
+    diagram_ = builder.Build();
+    simulator_ = std::make_unique<systems::Simulator<double>>(*diagram_);
+    simulator_->set_target_realtime_rate(target_realtime_rate);
+
+    // onInit() must return promptly, so the loop runs on its own thread.
+    running_ = true;
+    simulation_thread_ = std::thread([this]() { this->RunSimulation(); });
+  }
+
+  void RunSimulation() {
+    simulator_->Initialize();
+    while (running_ && ros::ok()) {
+      simulator_->StepTo(simulator_->get_context().get_time() +
+                         step_duration_);
+    }
+  }
+
+  double step_duration_{0.1};
+
+  std::unique_ptr<systems::Diagram<double>> diagram_;
+  std::unique_ptr<systems::Simulator<double>> simulator_;
+
+  std::atomic<bool> running_{false};
+  std::thread simulation_thread_;
+};
+
+}  // namespace drake_ros_systems
@@ -0,0 +1,257 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <random>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "drake/common/drake_assert.h"
+#include "drake/common/drake_copyable.h"
+
+namespace drake_ros_systems {
+
+/**
+ * Parameters of the emulated link used by NetworkImpairment. All times are
+ * wall-clock seconds. The defaults describe a perfect link.
+ */
+struct NetworkImpairmentConfig {
+  /// Shape of the per-message delay distribution.
+  enum class DelayDistribution {
+    /// Every message is delayed by exactly `delay`.
+    kConstant,
+    /// Uniform on [delay - jitter, delay + jitter].
+    kUniform,
+    /// Normal with mean `delay` and standard deviation `jitter`.
+    kNormal,
+    /// `delay` plus an exponential tail with mean `jitter`.
+    kExponential,
+  };
+
+  /// Nominal one-way delay.
+  double delay{0.0};
+
+  /// Spread of the delay; its meaning depends on `distribution`.
+  double jitter{0.0};
+
+  DelayDistribution distribution{DelayDistribution::kConstant};
+
+  /// Probability in [0, 1] that a message is silently dropped.
+  double loss_probability{0.0};
+
+  /// Probability in [0, 1] that a message is held back by `reorder_delay`
+  /// so that later messages overtake it. Jitter alone never reorders, like a
+  /// TCP link.
+  double reorder_probability{0.0};
+
+  /// Extra hold applied to a message selected for reordering.
+  double reorder_delay{0.0};
+
+  /// Seed of the random engine. The same seed and the same sequence of
+  /// messages always produce the same drop, delay and reorder decisions.
+  std::uint32_t seed{0};
+};
+
+/**
+ * Emulates an impaired network link between a producer and a delivery
+ * callback. Messages handed to Send() are dropped, delayed and reordered
+ * according to a NetworkImpairmentConfig, then handed to the delivery
+ * callback on an internal thread once their delivery time has come.
+ *
+ * All random decisions are made in Send(), in call order, from a single
+ * engine seeded by the config, so a given input sequence is impaired
+ * identically on every run. Messages still in flight when this object is
+ * destroyed are discarded.
+ *
+ * @tparam T type of the message carried over the link.
+ */
+template <typename T>
+class NetworkImpairment {
+ public:
+  DRAKE_NO_COPY_NO_MOVE_NO_ASSIGN(NetworkImpairment)
+
+  /**
+   * @param[in] config The link parameters.
+   *
+   * @param deliver Invoked on the internal thread for every message that
+   * survives the link, in delivery order.
+   */
+  NetworkImpairment(const NetworkImpairmentConfig& config,
+                    std::function<void(const T&)> deliver)
+      : config_(config), deliver_(std::move(deliver)), engine_(config.seed) {
+    DRAKE_DEMAND(deliver_ != nullptr);
+    DRAKE_DEMAND(config_.delay >= 0.0 && config_.jitter >= 0.0);
+    DRAKE_DEMAND(config_.reorder_delay >= 0.0);
+    DRAKE_DEMAND(config_.loss_probability >= 0.0 &&
+                 config_.loss_probability <= 1.0);
+    DRAKE_DEMAND(config_.reorder_probability >= 0.0 &&
+                 config_.reorder_probability <= 1.0);
+    thread_ = std::thread([this]() { this->Run(); });
+  }
+
+  ~NetworkImpairment() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stopping_ = true;
+    }
+    condition_variable_.notify_all();
+    thread_.join();
+  }
+
+  const NetworkImpairmentConfig& get_config() const { return config_; }
+
+  /// Puts a copy of @p message on the link, unless it is dropped. Thread
+  /// safe.
+  void Send(const T& message) { Enqueue(message); }
+
+  /// Moves @p message into the link, unless it is dropped. Thread safe.
+  void Send(T&& message) { Enqueue(std::move(message)); }
+
+  /// Returns the number of messages handed to Send().
+  int get_sent_count() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return sent_count_;
+  }
+
+  /// Returns the number of messages dropped by the link.
+  int get_dropped_count() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return dropped_count_;
+  }
+
+  /// Returns the number of messages held back for reordering.
+  int get_reordered_count() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return reordered_count_;
+  }
+
+ private:
+  // Copies or moves @p message into the queue once it is known not to be
+  // dropped.
+  template <typename Message>
+  void Enqueue(Message&& message) {
+    const Clock::time_point now = Clock::now();
+    std::unique_lock<std::mutex> lock(mutex_);
+    ++sent_count_;
+    if (uniform_(engine_) < config_.loss_probability) {
+      ++dropped_count_;
+      return;
+    }
+    const double delay = SampleDelay();
+    const bool reorder = uniform_(engine_) < config_.reorder_probability;
+
+    Clock::time_point deliver_at = now + ToDuration(delay);
+    if (reorder) {
+      ++reordered_count_;
+      deliver_at += ToDuration(config_.reorder_delay);
+    } else {
+      // Keep in-order messages in order regardless of jitter.
+      deliver_at = std::max(deliver_at, last_in_order_delivery_);
+      last_in_order_delivery_ = deliver_at;
+    }
+    in_flight_.push(
+        Pending{deliver_at, next_sequence_++, std::forward<Message>(message)});
+    lock.unlock();
+    condition_variable_.notify_all();
+  }
+
+  using Clock = std::chrono::steady_clock;
+
+  struct Pending {
+    Clock::time_point deliver_at;
+    std::uint64_t sequence;
+    T message;
+  };
+
+  // Orders the queue so that the earliest delivery, then the earliest Send(),
+  // is on top.
+  struct Later {
+    bool operator()(const Pending& a, const Pending& b) const {
+      if (a.deliver_at != b.deliver_at) return a.deliver_at > b.deliver_at;
+      return a.sequence > b.sequence;
+    }
+  };
+
+  static Clock::duration ToDuration(double seconds) {
+    return std::chrono::duration_cast<Clock::duration>(
+        std::chrono::duration<double>(seconds));
+  }
+
+  // Must be called with mutex_ held.
+  double SampleDelay() {
+    using Distribution = NetworkImpairmentConfig::DelayDistribution;
+    double delay = config_.delay;
+    switch (config_.distribution) {
+      case Distribution::kConstant:
+        break;
+      case Distribution::kUniform:
+        delay += config_.jitter * (2.0 * uniform_(engine_) - 1.0);
+        break;
+      case Distribution::kNormal:
+        delay += config_.jitter * normal_(engine_);
+        break;
+      case Distribution::kExponential:
+        if (config_.jitter > 0.0)
+          delay += -config_.jitter * std::log(1.0 - uniform_(engine_));
+        break;
+    }
+    return std::max(delay, 0.0);
+  }
+
+  void Run() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (!stopping_) {
+      if (in_flight_.empty()) {
+        condition_variable_.wait(lock);
+        continue;
+      }
+      const Clock::time_point deliver_at = in_flight_.top().deliver_at;
+      if (Clock::now() < deliver_at) {
+        // Wakes early if Send() queues something due sooner.
+        condition_variable_.wait_until(lock, deliver_at);
+        continue;
+      }
+      T message = std::move(const_cast<Pending&>(in_flight_.top()).message);
+      in_flight_.pop();
+      // Deliver without holding the lock so Send() is never blocked by the
+      // consumer.
+      lock.unlock();
+      deliver_(message);
+      lock.lock();
+    }
+  }
+
+  const NetworkImpairmentConfig config_;
+  const std::function<void(const T&)> deliver_;
+
+  // The mutex that guards everything below.
+  mutable std::mutex mutex_;
+  std::condition_variable condition_variable_;
+
+  std::mt19937 engine_;
+  std::uniform_real_distribution<double> uniform_{0.0, 1.0};
+  std::normal_distribution<double> normal_{0.0, 1.0};
+
+  std::priority_queue<Pending, std::vector<Pending>, Later> in_flight_;
+  Clock::time_point last_in_order_delivery_{};
+  std::uint64_t next_sequence_{0};
+
+  int sent_count_{0};
+  int dropped_count_{0};
+  int reordered_count_{0};
+
+  bool stopping_{false};
+
+  // Declared last so that it starts after, and is joined before, the members
+  // it uses are torn down.
+  std::thread thread_;
+};
+
+}  // namespace drake_ros_systems
@@ -0,0 +1,114 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "drake/common/drake_copyable.h"
+#include "drake/systems/framework/leaf_system.h"
+
+#include "rclcpp/rclcpp.hpp"
+
+namespace drake_ros_systems {
+
+using namespace drake;
+
+/**
+ * Publishes a ROS 2 message containing information from its input port. The
+ * ROS 2 counterpart of RosPublisherSystem.
+ *
+ * When the middleware supports loaned messages, the message is written
+ * straight into middleware-owned memory and published without
+ * serialization. Otherwise it is published by unique pointer, which rclcpp
+ * hands over to intra-process subscribers without a copy when the node was
+ * created with `use_intra_process_comms(true)`.
+ *
+ * @ingroup message_passing
+ */
+template <typename RosMessage>
+class Ros2PublisherSystem : public systems::LeafSystem<double> {
+ public:
+  DRAKE_NO_COPY_NO_MOVE_NO_ASSIGN(Ros2PublisherSystem)
+
+  /**
+   * A factory method that returns an %Ros2PublisherSystem that takes
+   * Value<RosMessage> message objects on its sole abstract-valued input port.
+   *
+   * @tparam RosMessage message type to publish.
+   *
+   * @param[in] topic The ROS 2 topic on which to publish.
+   *
+   * @param node The ROS 2 node that owns the publisher.
+   *
+   * @param[in] qos The quality of service of the publisher.
+   */
+  static std::unique_ptr<Ros2PublisherSystem<RosMessage>> Make(
+      const std::string& topic, rclcpp::Node* node,
+      const rclcpp::QoS& qos = rclcpp::QoS(10)) {
+    return std::make_unique<Ros2PublisherSystem<RosMessage>>(topic, node, qos);
+  }
+
+  Ros2PublisherSystem(const std::string& topic, rclcpp::Node* node,
+                      const rclcpp::QoS& qos = rclcpp::QoS(10))
+      : topic_(topic), node_(node) {
+    DRAKE_DEMAND(node_ != nullptr);
+
+    publisher_ = node_->create_publisher<RosMessage>(topic, qos);
+
+    DeclareAbstractInputPort();
+    set_name(make_name(topic_));
+  }
+
+  ~Ros2PublisherSystem() override{};
+
+  const std::string& get_topic_name() const { return topic_; }
+
+  /// Returns the default name for a system that publishes @p topic.
+  static std::string make_name(const std::string& topic) {
+    return "Ros2PublisherSystem(" + topic + ")";
+  }
+
+  /**
+   * Sets the publishing period of this system. See
+   * LeafSystem::DeclarePublishPeriodSec() for details about the semantics of
+   * parameter `period`.
+   */
+  void set_publish_period(double period) {
+    LeafSystem<double>::DeclarePeriodicPublish(period);
+  }
+
+  /**
+   * Takes the message from the input port of the context and publishes it
+   * onto a ROS 2 topic.
+   */
+  void DoPublish(
+      const systems::Context<double>& context,
+      const std::vector<const systems::PublishEvent<double>*>&) const override {
+    SPDLOG_TRACE(drake::log(), "Publishing ROS 2 {} message", topic_);
+
+    const systems::AbstractValue* const input_value =
+        this->EvalAbstractInput(context, kPortIndex);
+    DRAKE_ASSERT(input_value != nullptr);
+    const RosMessage& message = input_value->GetValue<RosMessage>();
+
+    if (publisher_->can_loan_messages()) {
+      auto loaned_message = publisher_->borrow_loaned_message();
+      loaned_message.get() = message;
+      publisher_->publish(std::move(loaned_message));
+    } else {
+      publisher_->publish(std::make_unique<RosMessage>(message));
+    }
+  }
+
+ private:
+  // The topic on which to publish ROS 2 messages.
+  const std::string topic_;
+
+  rclcpp::Node* const node_{};
+  typename rclcpp::Publisher<RosMessage>::SharedPtr publisher_;
+
+  const int kPortIndex = 0;
+};
+
+}  // namespace drake_ros_systems
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <memory>
+#include <string>
+
+#include "drake/common/drake_copyable.h"
+
+#include "rclcpp/rclcpp.hpp"
+
+#include "drake_ros_systems/subscriber_system_base.h"
+
+namespace drake_ros_systems {
+
+using namespace drake;
+
+/**
+ * Receives ROS 2 messages from a given topic and outputs them to a
+ * System<double>'s port. The ROS 2 counterpart of RosSubscriberSystem, with
+ * the same State layout, message counting and WaitForMessage() semantics.
+ *
+ * Messages are taken as unique pointers, so intra-process publishers hand
+ * them over without serialization, and rclcpp only copies them when several
+ * subscriptions share one. They are then swapped into the receive buffer.
+ * The node's callbacks must be spun by an executor on another thread for
+ * messages to arrive.
+ */
+template <typename RosMessage>
+class Ros2SubscriberSystem : public SubscriberSystemBase<RosMessage> {
+ public:
+  DRAKE_NO_COPY_NO_MOVE_NO_ASSIGN(Ros2SubscriberSystem)
+
+  /**
+   * A factory method that returns an %Ros2SubscriberSystem that provides
+   * Value<RosMessage> message objects on its sole abstract-valued output
+   * port.
+   *
+   * @tparam RosMessage message type to receive.
+   *
+   * @param[in] topic The ROS 2 topic to subscribe to.
+   *
+   * @param node The ROS 2 node that owns the subscription.
+   *
+   * @param[in] qos The quality of service of the subscription.
+   */
+  static std::unique_ptr<Ros2SubscriberSystem<RosMessage>> Make(
+      const std::string& topic, rclcpp::Node* node,
+      const rclcpp::QoS& qos = rclcpp::QoS(100)) {
+    return std::make_unique<Ros2SubscriberSystem<RosMessage>>(topic, node,
+                                                              qos);
+  }
+
+  Ros2SubscriberSystem(const std::string& topic, rclcpp::Node* node,
+                       const rclcpp::QoS& qos = rclcpp::QoS(100))
+      : topic_(topic), node_(node) {
+    DRAKE_DEMAND(node_ != nullptr);
+
+    subscription_ = node_->create_subscription<RosMessage>(
+        topic, qos, [this](std::unique_ptr<RosMessage> message) {
+          SPDLOG_TRACE(drake::log(), "Receiving ROS 2 {} message", topic_);
+          this->HandleMessage(message.get());
+        });
+
+    this->set_name(make_name(topic_));
+  }
+
+  ~Ros2SubscriberSystem() override{};
+
+  const std::string& get_topic_name() const { return topic_; }
+
+  /// Returns the default name for a system that subscribes to @p topic.
+  static std::string make_name(const std::string& topic) {
+    return "Ros2SubscriberSystem(" + topic + ")";
+  }
+
+ private:
+  // The topic on which to receive ROS 2 messages.
+  const std::string topic_;
+
+  rclcpp::Node* const node_{};
+  typename rclcpp::Subscription<RosMessage>::SharedPtr subscription_;
+};
+
+}  // namespace drake_ros_systems
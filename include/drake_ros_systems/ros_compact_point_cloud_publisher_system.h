@@ -0,0 +1,104 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "drake/common/drake_copyable.h"
+#include "drake/perception/point_cloud.h"
+#include "drake/systems/framework/leaf_system.h"
+
+#include "ros/ros.h"
+
+#include "drake_ros_systems/CompactPointCloud.h"
+#include "drake_ros_systems/compact_point_cloud_codec.h"
+
+namespace drake_ros_systems {
+
+using namespace drake;
+
+/**
+ * Publishes the perception::PointCloud on its sole abstract-valued input port
+ * as a bandwidth-saving CompactPointCloud message. See
+ * CompactPointCloudEncoder for the encoding and its precision, and
+ * RosCompactPointCloudSubscriberSystem for the receiving side.
+ */
+class RosCompactPointCloudPublisherSystem : public systems::LeafSystem<double> {
+ public:
+  DRAKE_NO_COPY_NO_MOVE_NO_ASSIGN(RosCompactPointCloudPublisherSystem)
+
+  /**
+   * @param[in] topic The ROS topic on which to publish.
+   *
+   * @param[in] frame_id The frame the input clouds are expressed in.
+   *
+   * @param node_handle The ROS context.
+   *
+   * @param[in] options Quantization and packing options.
+   */
+  RosCompactPointCloudPublisherSystem(
+      const std::string& topic, const std::string& frame_id,
+      ros::NodeHandle* node_handle,
+      const CompactPointCloudOptions& options = CompactPointCloudOptions{})
+      : topic_(topic), node_handle_(node_handle), encoder_(options) {
+    DRAKE_DEMAND(node_handle_ != nullptr);
+
+    publisher_ = node_handle_->advertise<CompactPointCloud>(topic, 1);
+    message_.header.frame_id = frame_id;
+
+    DeclareAbstractInputPort();
+    set_name(make_name(topic_));
+  }
+
+  ~RosCompactPointCloudPublisherSystem() override{};
+
+  const std::string& get_topic_name() const { return topic_; }
+
+  /// Returns the default name for a system that publishes @p topic.
+  static std::string make_name(const std::string& topic) {
+    return "RosCompactPointCloudPublisherSystem(" + topic + ")";
+  }
+
+  /**
+   * Sets the publishing period of this system. See
+   * LeafSystem::DeclarePublishPeriodSec() for details about the semantics of
+   * parameter `period`.
+   */
+  void set_publish_period(double period) {
+    LeafSystem<double>::DeclarePeriodicPublish(period);
+  }
+
+  /**
+   * Encodes the cloud from the input port of the context into the reused
+   * message and publishes it onto a ROS topic.
+   */
+  void DoPublish(
+      const systems::Context<double>& context,
+      const std::vector<const systems::PublishEvent<double>*>&) const override {
+    SPDLOG_TRACE(drake::log(), "Publishing ROS {} message", topic_);
+
+    const systems::AbstractValue* const input_value =
+        this->EvalAbstractInput(context, kPortIndex);
+    DRAKE_ASSERT(input_value != nullptr);
+
+    message_.header.stamp = ros::Time(context.get_time());
+    encoder_.Encode(input_value->GetValue<perception::PointCloud>(),
+                    &message_);
+    publisher_.publish(message_);
+  }
+
+ private:
+  // The topic on which to publish clouds.
+  const std::string topic_;
+
+  ros::NodeHandle* const node_handle_{};
+  ros::Publisher publisher_;
+
+  // The encoder and message are reused by every publish.
+  mutable CompactPointCloudEncoder encoder_;
+  mutable CompactPointCloud message_;
+
+  const int kPortIndex = 0;
+};
+
+}  // namespace drake_ros_systems
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include "drake/common/drake_copyable.h"
+#include "drake/perception/point_cloud.h"
+
+#include "ros/ros.h"
+
+#include "drake_ros_systems/CompactPointCloud.h"
+#include "drake_ros_systems/compact_point_cloud_codec.h"
+#include "drake_ros_systems/subscriber_system_base.h"
+
+namespace drake_ros_systems {
+
+using namespace drake;
+
+/**
+ * Receives CompactPointCloud messages, as published by
+ * RosCompactPointCloudPublisherSystem, and outputs them decoded into a
+ * perception::PointCloud. Decoding happens on the ROS callback thread;
+ * malformed messages are dropped.
+ */
+class RosCompactPointCloudSubscriberSystem
+    : public SubscriberSystemBase<perception::PointCloud> {
+ public:
+  DRAKE_NO_COPY_NO_MOVE_NO_ASSIGN(RosCompactPointCloudSubscriberSystem)
+
+  /**
+   * @param[in] topic The ROS topic to subscribe to.
+   *
+   * @param node_handle The ROS context.
+   */
+  RosCompactPointCloudSubscriberSystem(const std::string& topic,
+                                       ros::NodeHandle* node_handle)
+      : topic_(topic), node_handle_(node_handle) {
+    DRAKE_DEMAND(node_handle_ != nullptr);
+
+    subscriber_ = node_handle_->subscribe(
+        topic, 1, &RosCompactPointCloudSubscriberSystem::HandleCloud, this);
+
+    set_name(make_name(topic_));
+  }
+
+  ~RosCompactPointCloudSubscriberSystem() override{};
+
+  const std::string& get_topic_name() const { return topic_; }
+
+  /// Returns the default name for a system that subscribes to @p topic.
+  static std::string make_name(const std::string& topic) {
+    return "RosCompactPointCloudSubscriberSystem(" + topic + ")";
+  }
+
+ private:
+  void HandleCloud(const CompactPointCloud::ConstPtr& message) {
+    SPDLOG_TRACE(drake::log(), "Receiving ROS {} message", topic_);
+    std::lock_guard<std::mutex> lock(decoding_mutex_);
+    if (!DecodeCompactPointCloud(*message, &scratch_)) {
+      ROS_WARN_THROTTLE(1.0, "%s: dropping malformed CompactPointCloud",
+                        topic_.c_str());
+      return;
+    }
+    HandleMessage(&scratch_);
+  }
+
+  // The topic on which to receive clouds.
+  const std::string topic_;
+
+  ros::NodeHandle* const node_handle_{};
+
+  // The mutex that guards scratch_.
+  std::mutex decoding_mutex_;
+
+  // The cloud being decoded; swapped with the receive buffer once complete.
+  perception::PointCloud scratch_;
+
+  ros::Subscriber subscriber_;
+};
+
+}  // namespace drake_ros_systems
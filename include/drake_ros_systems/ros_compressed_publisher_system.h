@@ -0,0 +1,284 @@
+#pragma once
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "drake/common/drake_copyable.h"
+#include "drake/systems/framework/leaf_system.h"
+
+#include "ros/ros.h"
+
+#include "drake_ros_systems/CompressedLinkReport.h"
+#include "drake_ros_systems/CompressedMessage.h"
+#include "drake_ros_systems/compressed_message_codec.h"
+
+namespace drake_ros_systems {
+
+using namespace drake;
+
+/**
+ * Options of RosCompressedPublisherSystem.
+ */
+struct CompressedRelayOptions {
+  /// A CompressedMessage::CODEC_* constant.
+  uint8_t codec{CompressedMessage::CODEC_LZ4};
+
+  /// The range the compression level adapts in; 0 as maximum means the
+  /// codec's highest level, see GetMaxCompressionLevel().
+  int min_level{1};
+  int max_level{0};
+
+  /// How long, in seconds, the envelopes the receiver has not seen yet may
+  /// take to drain at the measured bandwidth before the level is raised.
+  /// The level is lowered again when the link drains in a quarter of that
+  /// time for several reports in a row.
+  double max_latency{0.5};
+};
+
+/**
+ * Publishes the RosMessage on its sole abstract-valued input port as a
+ * compressed CompressedMessage envelope, for large messages of any type
+ * (clouds, grids, custom arrays) crossing a slow link. The
+ * RosCompressedSubscriberSystem on the other end outputs the original
+ * message again.
+ *
+ * A publish only serializes the message and hands the bytes over to a worker
+ * thread, which compresses and publishes them, so the simulation never waits
+ * for the compressor. If the worker is still busy with the previous message,
+ * the waiting one is replaced by the newer one and counted as dropped.
+ *
+ * The compression level adapts to the link: the receiver reports its
+ * throughput and the last envelope it got on `<topic>/link_report`, from
+ * which the bytes still in flight and the time they take to drain are
+ * estimated. When that time exceeds `max_latency`, the level is raised by
+ * one, trading CPU time for bandwidth; when the link keeps up easily, it is
+ * lowered again. The reports are received on @p node_handle's callback
+ * queue, which must be spun.
+ */
+template <typename RosMessage>
+class RosCompressedPublisherSystem : public systems::LeafSystem<double> {
+ public:
+  DRAKE_NO_COPY_NO_MOVE_NO_ASSIGN(RosCompressedPublisherSystem)
+
+  /**
+   * @param[in] topic The ROS topic on which to publish envelopes.
+   *
+   * @param node_handle The ROS context.
+   *
+   * @param[in] options Codec and adaptation options.
+   */
+  RosCompressedPublisherSystem(
+      const std::string& topic, ros::NodeHandle* node_handle,
+      const CompressedRelayOptions& options = CompressedRelayOptions{})
+      : topic_(topic),
+        node_handle_(node_handle),
+        min_level_(options.min_level),
+        max_level_(options.max_level > 0
+                       ? options.max_level
+                       : GetMaxCompressionLevel(options.codec)),
+        max_latency_(options.max_latency),
+        compressor_(options.codec),
+        level_(options.min_level) {
+    DRAKE_DEMAND(node_handle_ != nullptr);
+    DRAKE_DEMAND(min_level_ >= 1 && min_level_ <= max_level_ &&
+                 max_level_ <= GetMaxCompressionLevel(options.codec));
+    DRAKE_DEMAND(max_latency_ > 0.0);
+
+    publisher_ = node_handle_->advertise<CompressedMessage>(topic, 1);
+    report_subscriber_ = node_handle_->subscribe(
+        topic + "/link_report", 1,
+        &RosCompressedPublisherSystem<RosMessage>::HandleLinkReport, this);
+    envelope_.datatype = ros::message_traits::DataType<RosMessage>::value();
+    envelope_.md5sum = ros::message_traits::MD5Sum<RosMessage>::value();
+    worker_ = std::thread([this]() { this->CompressAndPublish(); });
+
+    DeclareAbstractInputPort();
+    set_name(make_name(topic_));
+  }
+
+  ~RosCompressedPublisherSystem() override {
+    report_subscriber_.shutdown();
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stop_ = true;
+    }
+    condition_variable_.notify_one();
+    worker_.join();
+  }
+
+  const std::string& get_topic_name() const { return topic_; }
+
+  /// Returns the default name for a system that publishes @p topic.
+  static std::string make_name(const std::string& topic) {
+    return "RosCompressedPublisherSystem(" + topic + ")";
+  }
+
+  /**
+   * Sets the publishing period of this system. See
+   * LeafSystem::DeclarePublishPeriodSec() for details about the semantics of
+   * parameter `period`.
+   */
+  void set_publish_period(double period) {
+    LeafSystem<double>::DeclarePeriodicPublish(period);
+  }
+
+  /// Returns the compression level the next message will be compressed at.
+  int get_compression_level() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return level_;
+  }
+
+  /// Returns the last measured link bandwidth, in bytes per second, or 0
+  /// before the first report.
+  double get_link_bandwidth() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return bandwidth_;
+  }
+
+  /// Returns the number of messages replaced before they were compressed.
+  int get_dropped_message_count() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return dropped_message_count_;
+  }
+
+  /**
+   * Serializes the message from the input port of the context and hands it
+   * over to the compression thread.
+   */
+  void DoPublish(
+      const systems::Context<double>& context,
+      const std::vector<const systems::PublishEvent<double>*>&) const override {
+    SPDLOG_TRACE(drake::log(), "Publishing ROS {} message", topic_);
+
+    const systems::AbstractValue* const input_value =
+        this->EvalAbstractInput(context, kPortIndex);
+    DRAKE_ASSERT(input_value != nullptr);
+
+    namespace ser = ros::serialization;
+    const RosMessage& message = input_value->GetValue<RosMessage>();
+    const uint32_t length = ser::serializationLength(message);
+    serialized_.resize(length);
+    ser::OStream stream(serialized_.data(), length);
+    ser::serialize(stream, message);
+
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (has_pending_) ++dropped_message_count_;
+      // Swapped, so both buffers keep their capacity.
+      pending_.swap(serialized_);
+      has_pending_ = true;
+    }
+    condition_variable_.notify_one();
+  }
+
+ private:
+  // Worker thread: compresses and publishes the pending message until the
+  // system is destroyed.
+  void CompressAndPublish() {
+    std::vector<uint8_t> bytes;
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+      condition_variable_.wait(lock, [this]() {
+        return stop_ || has_pending_;
+      });
+      if (stop_) return;
+      bytes.swap(pending_);
+      has_pending_ = false;
+      const int level = level_;
+      lock.unlock();
+
+      compressor_.Compress(bytes, level, &envelope_);
+      envelope_.stamp = ros::Time(ros::WallTime::now().toSec());
+      publisher_.publish(envelope_);
+
+      lock.lock();
+      sent_bytes_ += envelope_.data.size();
+      in_flight_.emplace_back(envelope_.sequence, sent_bytes_);
+      // Envelopes the receiver never reports on, e.g. dropped ones, must not
+      // pile up.
+      if (in_flight_.size() > kMaxInFlight) {
+        acknowledged_bytes_ = in_flight_.front().second;
+        in_flight_.pop_front();
+      }
+      ++envelope_.sequence;
+    }
+  }
+
+  // Adapts the compression level to the receiver's view of the link.
+  void HandleLinkReport(const CompressedLinkReport::ConstPtr& report) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (report->bytes_per_second <= 0.0) return;
+    bandwidth_ = report->bytes_per_second;
+
+    // Bytes sent after the envelope the receiver got last.
+    while (!in_flight_.empty() &&
+           static_cast<int32_t>(in_flight_.front().first -
+                                report->last_sequence) <= 0) {
+      acknowledged_bytes_ = in_flight_.front().second;
+      in_flight_.pop_front();
+    }
+    const double drain_time = (sent_bytes_ - acknowledged_bytes_) / bandwidth_;
+
+    if (drain_time > max_latency_) {
+      level_ = std::min(level_ + 1, max_level_);
+      num_fast_reports_ = 0;
+    } else if (drain_time < 0.25 * max_latency_ &&
+               ++num_fast_reports_ >= kNumFastReportsToLower) {
+      level_ = std::max(level_ - 1, min_level_);
+      num_fast_reports_ = 0;
+    }
+  }
+
+  // The topic on which to publish envelopes.
+  const std::string topic_;
+
+  ros::NodeHandle* const node_handle_{};
+  ros::Publisher publisher_;
+  ros::Subscriber report_subscriber_;
+
+  const int min_level_;
+  const int max_level_;
+  const double max_latency_;
+
+  // Simulation thread only.
+  mutable std::vector<uint8_t> serialized_;
+
+  // Worker thread only.
+  MessageCompressor compressor_;
+  CompressedMessage envelope_;
+
+  // Guards everything below, shared by the simulation, worker and report
+  // threads.
+  mutable std::mutex mutex_;
+  mutable std::condition_variable condition_variable_;
+  mutable std::vector<uint8_t> pending_;
+  mutable bool has_pending_{false};
+  mutable int dropped_message_count_{0};
+  bool stop_{false};
+
+  int level_;
+  double bandwidth_{0.0};
+  int num_fast_reports_{0};
+  // Total bytes sent, and sent up to the envelope last reported received.
+  uint64_t sent_bytes_{0};
+  uint64_t acknowledged_bytes_{0};
+  // Sequence number and running sent_bytes_ of envelopes not reported yet.
+  std::deque<std::pair<uint32_t, uint64_t>> in_flight_;
+
+  static constexpr std::size_t kMaxInFlight = 1024;
+  static constexpr int kNumFastReportsToLower = 3;
+
+  const int kPortIndex = 0;
+
+  // Started by the constructor and joined by the destructor.
+  std::thread worker_;
+};
+
+}  // namespace drake_ros_systems
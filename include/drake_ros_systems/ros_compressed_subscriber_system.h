@@ -0,0 +1,152 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "drake/common/drake_copyable.h"
+
+#include "ros/ros.h"
+
+#include "drake_ros_systems/CompressedLinkReport.h"
+#include "drake_ros_systems/CompressedMessage.h"
+#include "drake_ros_systems/compressed_message_codec.h"
+#include "drake_ros_systems/subscriber_system_base.h"
+
+namespace drake_ros_systems {
+
+using namespace drake;
+
+/**
+ * Receives CompressedMessage envelopes, as published by
+ * RosCompressedPublisherSystem<RosMessage>, and outputs the RosMessage they
+ * carry. Decompression and deserialization happen on the ROS callback
+ * thread; envelopes of another message type and malformed ones are dropped.
+ *
+ * Every @p report_period seconds of wall time, the system publishes a
+ * CompressedLinkReport with its throughput on `<topic>/link_report`, which
+ * the publisher adapts its compression level to. Reports are only sent when
+ * envelopes arrive.
+ */
+template <typename RosMessage>
+class RosCompressedSubscriberSystem : public SubscriberSystemBase<RosMessage> {
+ public:
+  DRAKE_NO_COPY_NO_MOVE_NO_ASSIGN(RosCompressedSubscriberSystem)
+
+  /**
+   * @param[in] topic The ROS topic to subscribe to.
+   *
+   * @param node_handle The ROS context.
+   *
+   * @param[in] report_period The wall time between two link reports, in
+   * seconds.
+   *
+   * @param[in] max_message_size The largest serialized message accepted, in
+   * bytes; larger envelopes are dropped before decompression.
+   */
+  RosCompressedSubscriberSystem(
+      const std::string& topic, ros::NodeHandle* node_handle,
+      double report_period = 0.5,
+      std::size_t max_message_size =
+          MessageDecompressor::kDefaultMaxUncompressedSize)
+      : topic_(topic),
+        node_handle_(node_handle),
+        report_period_(report_period),
+        decompressor_(max_message_size) {
+    DRAKE_DEMAND(node_handle_ != nullptr);
+    DRAKE_DEMAND(report_period_ > 0.0);
+
+    report_publisher_ = node_handle_->advertise<CompressedLinkReport>(
+        topic + "/link_report", 1);
+    subscriber_ = node_handle_->subscribe(
+        topic, 10, &RosCompressedSubscriberSystem<RosMessage>::HandleEnvelope,
+        this);
+
+    this->set_name(make_name(topic_));
+  }
+
+  ~RosCompressedSubscriberSystem() override{};
+
+  const std::string& get_topic_name() const { return topic_; }
+
+  /// Returns the default name for a system that subscribes to @p topic.
+  static std::string make_name(const std::string& topic) {
+    return "RosCompressedSubscriberSystem(" + topic + ")";
+  }
+
+ private:
+  void HandleEnvelope(const CompressedMessage::ConstPtr& envelope) {
+    SPDLOG_TRACE(drake::log(), "Receiving ROS {} message", topic_);
+    std::lock_guard<std::mutex> lock(decoding_mutex_);
+    ReportLink(*envelope);
+
+    if (envelope->md5sum !=
+        ros::message_traits::MD5Sum<RosMessage>::value()) {
+      ROS_WARN_THROTTLE(1.0, "%s: dropping envelope of type %s",
+                        topic_.c_str(), envelope->datatype.c_str());
+      return;
+    }
+    if (!decompressor_.Decompress(*envelope, &bytes_)) {
+      ROS_WARN_THROTTLE(1.0, "%s: dropping malformed envelope",
+                        topic_.c_str());
+      return;
+    }
+    try {
+      ros::serialization::IStream stream(bytes_.data(), bytes_.size());
+      ros::serialization::deserialize(stream, scratch_);
+    } catch (const ros::serialization::StreamOverrunException&) {
+      ROS_WARN_THROTTLE(1.0, "%s: dropping truncated %s", topic_.c_str(),
+                        envelope->datatype.c_str());
+      return;
+    }
+    this->HandleMessage(&scratch_);
+  }
+
+  // Accounts for @p envelope and publishes a link report once a report
+  // period has passed.
+  void ReportLink(const CompressedMessage& envelope) {
+    const ros::WallTime now = ros::WallTime::now();
+    if (window_start_.isZero()) {
+      // The first envelope only starts the window.
+      window_start_ = now;
+      return;
+    }
+    window_bytes_ += envelope.data.size();
+    const double elapsed = (now - window_start_).toSec();
+    if (elapsed < report_period_) return;
+
+    report_.last_sequence = envelope.sequence;
+    report_.bytes_per_second = window_bytes_ / elapsed;
+    report_publisher_.publish(report_);
+    window_start_ = now;
+    window_bytes_ = 0;
+  }
+
+  // The topic on which to receive envelopes.
+  const std::string topic_;
+
+  ros::NodeHandle* const node_handle_{};
+  const double report_period_;
+
+  // The mutex that guards everything below.
+  std::mutex decoding_mutex_;
+
+  MessageDecompressor decompressor_;
+  std::vector<uint8_t> bytes_;
+
+  // The message being decoded; swapped with the receive buffer once
+  // complete.
+  RosMessage scratch_;
+
+  // Envelope bytes received since window_start_.
+  ros::WallTime window_start_;
+  uint64_t window_bytes_{0};
+  CompressedLinkReport report_;
+
+  ros::Publisher report_publisher_;
+  ros::Subscriber subscriber_;
+};
+
+}  // namespace drake_ros_systems
@@ -0,0 +1,256 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include <Eigen/Core>
+
+#include "drake/common/drake_copyable.h"
+#include "drake/perception/point_cloud.h"
+
+#include "ros/ros.h"
+#include "sensor_msgs/CameraInfo.h"
+#include "sensor_msgs/Image.h"
+#include "sensor_msgs/image_encodings.h"
+
+#include "drake_ros_systems/subscriber_system_base.h"
+
+namespace drake_ros_systems {
+
+using namespace drake;
+
+/**
+ * Options of RosDepthImageToPointCloudSystem.
+ */
+struct DepthImageToPointCloudOptions {
+  /// Only every `stride`-th pixel of every `stride`-th row is converted.
+  int stride{1};
+
+  /// Region of interest in pixels. A zero width or height extends the region
+  /// to the right or bottom edge of the image.
+  int roi_x{0};
+  int roi_y{0};
+  int roi_width{0};
+  int roi_height{0};
+
+  /// Depth in meters of one unit of a `16UC1` image.
+  float depth_scale_16u{0.001f};
+};
+
+/**
+ * Receives depth images and outputs them back-projected into a
+ * perception::PointCloud, expressed in the camera's optical frame.
+ *
+ * The pinhole intrinsics are read from the `CameraInfo` topic. Whenever they
+ * (or the ROI and stride they are combined with) change, the per-column and
+ * per-row ray tables `(u - cx) / fx` and `(v - cy) / fy` are rebuilt; every
+ * depth frame is then back-projected as `z * ray` with vectorized Eigen array
+ * expressions, on the ROS callback thread, so the simulation thread only
+ * receives the finished cloud. Frames arriving before the first `CameraInfo`
+ * are dropped.
+ *
+ * Both `16UC1` (scaled by DepthImageToPointCloudOptions::depth_scale_16u)
+ * and `32FC1` (meters) images are supported. The cloud stays organized: its
+ * size is the number of sampled pixels, row-major, and pixels without a valid
+ * depth produce NaN points.
+ */
+class RosDepthImageToPointCloudSystem
+    : public SubscriberSystemBase<perception::PointCloud> {
+ public:
+  DRAKE_NO_COPY_NO_MOVE_NO_ASSIGN(RosDepthImageToPointCloudSystem)
+
+  /**
+   * @param[in] depth_topic The ROS topic of the depth images.
+   *
+   * @param[in] camera_info_topic The ROS topic of the matching intrinsics.
+   *
+   * @param node_handle The ROS context.
+   *
+   * @param[in] options Subsampling and scaling options.
+   */
+  RosDepthImageToPointCloudSystem(
+      const std::string& depth_topic, const std::string& camera_info_topic,
+      ros::NodeHandle* node_handle,
+      const DepthImageToPointCloudOptions& options =
+          DepthImageToPointCloudOptions{})
+      : topic_(depth_topic), node_handle_(node_handle), options_(options) {
+    DRAKE_DEMAND(node_handle_ != nullptr);
+    DRAKE_DEMAND(options_.stride >= 1);
+    DRAKE_DEMAND(options_.roi_x >= 0 && options_.roi_y >= 0);
+    DRAKE_DEMAND(options_.roi_width >= 0 && options_.roi_height >= 0);
+
+    camera_info_subscriber_ = node_handle_->subscribe(
+        camera_info_topic, 1,
+        &RosDepthImageToPointCloudSystem::HandleCameraInfo, this);
+    depth_subscriber_ = node_handle_->subscribe(
+        depth_topic, 1, &RosDepthImageToPointCloudSystem::HandleDepthImage,
+        this);
+
+    set_name(make_name(topic_));
+  }
+
+  ~RosDepthImageToPointCloudSystem() override{};
+
+  const std::string& get_topic_name() const { return topic_; }
+
+  /// Returns the default name for a system that subscribes to @p topic.
+  static std::string make_name(const std::string& topic) {
+    return "RosDepthImageToPointCloudSystem(" + topic + ")";
+  }
+
+  /// Returns the number of frames dropped because they could not be
+  /// converted (no intrinsics yet or an unsupported encoding).
+  int get_dropped_frame_count() const {
+    std::lock_guard<std::mutex> lock(conversion_mutex_);
+    return dropped_frame_count_;
+  }
+
+ private:
+  void HandleCameraInfo(const sensor_msgs::CameraInfo::ConstPtr& info) {
+    std::lock_guard<std::mutex> lock(conversion_mutex_);
+    const double fx = info->K[0];
+    const double cx = info->K[2];
+    const double fy = info->K[4];
+    const double cy = info->K[5];
+    if (fx == fx_ && fy == fy_ && cx == cx_ && cy == cy_ &&
+        static_cast<int>(info->width) == info_width_ &&
+        static_cast<int>(info->height) == info_height_) {
+      return;
+    }
+    fx_ = fx;
+    fy_ = fy;
+    cx_ = cx;
+    cy_ = cy;
+    info_width_ = info->width;
+    info_height_ = info->height;
+    // The tables also depend on the image size, so they are rebuilt lazily
+    // by the next frame.
+    tables_width_ = -1;
+  }
+
+  void HandleDepthImage(const sensor_msgs::Image::ConstPtr& image) {
+    SPDLOG_TRACE(drake::log(), "Receiving ROS {} message", topic_);
+    namespace enc = sensor_msgs::image_encodings;
+    std::lock_guard<std::mutex> lock(conversion_mutex_);
+    const bool is_16u = image->encoding == enc::TYPE_16UC1;
+    const bool is_32f = image->encoding == enc::TYPE_32FC1;
+    const std::size_t pixel_size = is_16u ? 2 : 4;
+    if (fx_ == 0.0 || (!is_16u && !is_32f) || image->is_bigendian ||
+        image->step < image->width * pixel_size ||
+        image->data.size() <
+            static_cast<std::size_t>(image->height) * image->step) {
+      ++dropped_frame_count_;
+      return;
+    }
+    if (tables_width_ != static_cast<int>(image->width) ||
+        tables_height_ != static_cast<int>(image->height)) {
+      BuildRayTables(image->width, image->height);
+    }
+
+    const int num_columns = static_cast<int>(ray_x_.size());
+    const int num_rows = static_cast<int>(ray_y_.size());
+    const int num_points = num_columns * num_rows;
+    if (scratch_.size() != num_points) scratch_.resize(num_points);
+    auto xyzs = scratch_.mutable_xyzs();
+
+    const float kNaN = std::numeric_limits<float>::quiet_NaN();
+    // Sampled depths of one row, converted to meters.
+    Eigen::ArrayXf z(num_columns);
+    for (int row = 0; row < num_rows; ++row) {
+      const int v = first_row_ + row * options_.stride;
+      const std::uint8_t* const row_data =
+          image->data.data() + v * image->step;
+      if (is_16u) {
+        Eigen::Map<const Eigen::Array<std::uint16_t, Eigen::Dynamic, 1>, 0,
+                   Eigen::InnerStride<>>
+            raw(reinterpret_cast<const std::uint16_t*>(row_data) +
+                    first_column_,
+                num_columns, Eigen::InnerStride<>(options_.stride));
+        z = raw.cast<float>() * options_.depth_scale_16u;
+      } else {
+        Eigen::Map<const Eigen::ArrayXf, 0, Eigen::InnerStride<>> raw(
+            reinterpret_cast<const float*>(row_data) + first_column_,
+            num_columns, Eigen::InnerStride<>(options_.stride));
+        z = raw;
+      }
+      // A zero depth means "no return"; NaN stays NaN.
+      z = (z > 0.0f).select(z, kNaN);
+
+      auto row_xyzs = xyzs.middleCols(row * num_columns, num_columns);
+      row_xyzs.row(0) = (z * ray_x_).matrix().transpose();
+      row_xyzs.row(1) = (z * ray_y_[row]).matrix().transpose();
+      row_xyzs.row(2) = z.matrix().transpose();
+    }
+
+    HandleMessage(&scratch_);
+  }
+
+  // Must be called with conversion_mutex_ held.
+  void BuildRayTables(int width, int height) {
+    first_column_ = std::min(options_.roi_x, width);
+    first_row_ = std::min(options_.roi_y, height);
+    const int roi_width =
+        options_.roi_width > 0
+            ? std::min(options_.roi_width, width - first_column_)
+            : width - first_column_;
+    const int roi_height =
+        options_.roi_height > 0
+            ? std::min(options_.roi_height, height - first_row_)
+            : height - first_row_;
+    const int num_columns = (roi_width + options_.stride - 1) / options_.stride;
+    const int num_rows = (roi_height + options_.stride - 1) / options_.stride;
+
+    ray_x_.resize(num_columns);
+    for (int i = 0; i < num_columns; ++i)
+      ray_x_[i] = (first_column_ + i * options_.stride - cx_) / fx_;
+    ray_y_.resize(num_rows);
+    for (int i = 0; i < num_rows; ++i)
+      ray_y_[i] = (first_row_ + i * options_.stride - cy_) / fy_;
+
+    tables_width_ = width;
+    tables_height_ = height;
+  }
+
+  // The topic on which to receive depth images.
+  const std::string topic_;
+
+  ros::NodeHandle* const node_handle_{};
+  const DepthImageToPointCloudOptions options_;
+
+  // The mutex that guards everything below; the two subscriptions may be
+  // serviced by different spinner threads.
+  mutable std::mutex conversion_mutex_;
+
+  // Pinhole intrinsics from the latest CameraInfo, zero until one arrives.
+  double fx_{0.0};
+  double fy_{0.0};
+  double cx_{0.0};
+  double cy_{0.0};
+  int info_width_{0};
+  int info_height_{0};
+
+  // Ray tables of the sampled columns and rows, valid for images of
+  // tables_width_ x tables_height_ pixels.
+  Eigen::ArrayXf ray_x_;
+  Eigen::ArrayXf ray_y_;
+  int tables_width_{-1};
+  int tables_height_{-1};
+  int first_column_{0};
+  int first_row_{0};
+
+  // The cloud being filled; swapped with the receive buffer once complete.
+  perception::PointCloud scratch_;
+
+  int dropped_frame_count_{0};
+
+  ros::Subscriber camera_info_subscriber_;
+  ros::Subscriber depth_subscriber_;
+};
+
+}  // namespace drake_ros_systems
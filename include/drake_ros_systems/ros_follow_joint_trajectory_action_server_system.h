@@ -0,0 +1,417 @@
+#pragma once
+
+#include <algorithm>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <Eigen/Core>
+
+#include "boost/bind.hpp"
+
+#include "drake/common/drake_copyable.h"
+#include "drake/common/trajectories/piecewise_polynomial.h"
+#include "drake/systems/framework/leaf_system.h"
+
+#include "actionlib/server/action_server.h"
+#include "control_msgs/FollowJointTrajectoryAction.h"
+#include "ros/callback_queue.h"
+#include "ros/ros.h"
+
+namespace drake_ros_systems {
+
+using namespace drake;
+
+/**
+ * Hosts a `control_msgs/FollowJointTrajectory` action server inside the
+ * simulation, so that a motion stack can execute trajectories on simulated
+ * joints without an external controller node.
+ *
+ * The input port takes the measured joint state `[q; v]` and the output
+ * port provides the desired joint state `[q_d; v_d]`, both in the order of
+ * the joint names given to the constructor, e.g. for a
+ * systems::controllers::PidController or InverseDynamicsController.
+ *
+ * Goals are received on a private callback queue with its own spinner
+ * thread, validated, reordered into the system's joint order and handed
+ * over to the simulation, which starts them at the next step: the cubic
+ * Hermite spline through the current desired state and the goal's points
+ * (using their velocities, or finite-difference estimates if none are given)
+ * is computed once and kept in the State. Starting from the desired rather
+ * than the measured state keeps the output continuous when a goal preempts
+ * another one. Between goals, and after a goal was canceled, the last
+ * desired position is held; before the first goal, that is the measured
+ * position. A new goal preempts the active one.
+ *
+ * Feedback is published from the simulation thread at most every
+ * `feedback_period` seconds of simulation time. A goal succeeds once the
+ * trajectory has ended and every joint is within its goal position
+ * tolerance; it is aborted if that does not happen within the goal time
+ * tolerance.
+ */
+class RosFollowJointTrajectoryActionServerSystem
+    : public systems::LeafSystem<double> {
+ public:
+  DRAKE_NO_COPY_NO_MOVE_NO_ASSIGN(RosFollowJointTrajectoryActionServerSystem)
+
+  using Action = control_msgs::FollowJointTrajectoryAction;
+  using ActionServer = actionlib::ActionServer<Action>;
+  using GoalHandle = ActionServer::GoalHandle;
+
+  /**
+   * @param[in] action_name The name of the action, e.g.
+   * `arm_controller/follow_joint_trajectory`.
+   *
+   * @param[in] joint_names The controlled joints, in port order.
+   *
+   * @param node_handle The ROS context. Its callback queue is not used.
+   *
+   * @param[in] feedback_period The minimum simulation time between two
+   * feedback messages, in seconds.
+   *
+   * @param[in] default_goal_tolerance The position tolerance, in joint
+   * units, of joints whose goal tolerance is left at 0.
+   */
+  RosFollowJointTrajectoryActionServerSystem(
+      const std::string& action_name,
+      const std::vector<std::string>& joint_names,
+      ros::NodeHandle* node_handle, double feedback_period = 0.05,
+      double default_goal_tolerance = 0.01)
+      : joint_names_(joint_names),
+        num_joints_(static_cast<int>(joint_names.size())),
+        feedback_period_(feedback_period),
+        default_goal_tolerance_(default_goal_tolerance) {
+    DRAKE_DEMAND(node_handle != nullptr);
+    DRAKE_DEMAND(num_joints_ > 0);
+    DRAKE_DEMAND(feedback_period_ >= 0.0);
+    feedback_.joint_names = joint_names_;
+
+    DeclareInputPort(systems::kVectorValued, 2 * num_joints_);
+    DeclareVectorOutputPort(
+        systems::BasicVector<double>(2 * num_joints_),
+        &RosFollowJointTrajectoryActionServerSystem::CalcDesiredState);
+    DeclareAbstractState(
+        systems::AbstractValue::Make<ExecutionState>(ExecutionState{}));
+    DeclarePerStepEvent(systems::UnrestrictedUpdateEvent<double>(
+        systems::Event<double>::TriggerType::kPerStep));
+    DeclarePerStepEvent(systems::PublishEvent<double>(
+        systems::Event<double>::TriggerType::kPerStep));
+
+    // A copy of the caller's node handle, so that goals are served by the
+    // spinner below even while the caller's queue is not being spun.
+    action_node_handle_ = *node_handle;
+    action_node_handle_.setCallbackQueue(&callback_queue_);
+    server_ = std::make_unique<ActionServer>(
+        action_node_handle_, action_name,
+        boost::bind(&RosFollowJointTrajectoryActionServerSystem::HandleGoal,
+                    this, _1),
+        boost::bind(&RosFollowJointTrajectoryActionServerSystem::HandleCancel,
+                    this, _1),
+        false);
+    server_->start();
+    spinner_ = std::make_unique<ros::AsyncSpinner>(1, &callback_queue_);
+    spinner_->start();
+
+    set_name("RosFollowJointTrajectoryActionServerSystem(" + action_name +
+             ")");
+  }
+
+  ~RosFollowJointTrajectoryActionServerSystem() override {
+    spinner_->stop();
+    server_.reset();
+  }
+
+  const std::vector<std::string>& get_joint_names() const {
+    return joint_names_;
+  }
+
+ private:
+  // A validated goal, in the system's joint order.
+  struct Goal {
+    GoalHandle handle;
+    Eigen::VectorXd times;
+    Eigen::MatrixXd positions;
+    Eigen::MatrixXd velocities;
+    Eigen::VectorXd goal_tolerances;
+    double goal_time_tolerance{0.0};
+  };
+
+  // The trajectory being executed, kept in the State.
+  struct ExecutionState {
+    // The goal the trajectory belongs to; 0 before the first goal.
+    int sequence{0};
+    bool active{false};
+    trajectories::PiecewisePolynomial<double> q_d;
+    trajectories::PiecewisePolynomial<double> v_d;
+    // Held while no trajectory is active; empty until the first step.
+    Eigen::VectorXd hold;
+  };
+
+  // Action thread: validates a goal and hands it over to the simulation.
+  void HandleGoal(GoalHandle handle) {
+    const trajectory_msgs::JointTrajectory& trajectory =
+        handle.getGoal()->trajectory;
+    control_msgs::FollowJointTrajectoryResult result;
+    auto reject = [&](int error_code, const std::string& error) {
+      result.error_code = error_code;
+      result.error_string = error;
+      handle.setRejected(result, error);
+    };
+
+    // Goal joint index of each system joint.
+    std::vector<int> index(num_joints_, -1);
+    if (trajectory.joint_names.size() != joint_names_.size()) {
+      reject(result.INVALID_JOINTS, "expected " +
+                                        std::to_string(num_joints_) +
+                                        " joints");
+      return;
+    }
+    for (int j = 0; j < num_joints_; ++j) {
+      const auto it = std::find(trajectory.joint_names.begin(),
+                                trajectory.joint_names.end(), joint_names_[j]);
+      if (it == trajectory.joint_names.end()) {
+        reject(result.INVALID_JOINTS, "missing joint " + joint_names_[j]);
+        return;
+      }
+      index[j] = static_cast<int>(it - trajectory.joint_names.begin());
+    }
+
+    const int num_points = static_cast<int>(trajectory.points.size());
+    if (num_points == 0) {
+      reject(result.INVALID_GOAL, "empty trajectory");
+      return;
+    }
+    Goal goal;
+    goal.handle = handle;
+    goal.times.resize(num_points);
+    goal.positions.resize(num_joints_, num_points);
+    goal.velocities.resize(num_joints_, num_points);
+    bool has_velocities = true;
+    for (int i = 0; i < num_points; ++i) {
+      const trajectory_msgs::JointTrajectoryPoint& point =
+          trajectory.points[i];
+      goal.times[i] = point.time_from_start.toSec();
+      if (point.positions.size() != joint_names_.size() ||
+          goal.times[i] < 0.0 ||
+          (i > 0 && goal.times[i] <= goal.times[i - 1])) {
+        reject(result.INVALID_GOAL, "malformed point " + std::to_string(i));
+        return;
+      }
+      has_velocities &= point.velocities.size() == joint_names_.size();
+      for (int j = 0; j < num_joints_; ++j)
+        goal.positions(j, i) = point.positions[index[j]];
+    }
+    // The spline needs two knots, and a first point at time 0 replaces the
+    // current desired state as the first one.
+    if (num_points == 1 && goal.times[0] == 0.0) {
+      reject(result.INVALID_GOAL, "single point at time 0");
+      return;
+    }
+    goal.velocities.setZero();
+    if (has_velocities) {
+      for (int i = 0; i < num_points; ++i) {
+        for (int j = 0; j < num_joints_; ++j)
+          goal.velocities(j, i) = trajectory.points[i].velocities[index[j]];
+      }
+    } else {
+      // Zero at the ends, finite differences in between.
+      for (int i = 1; i + 1 < num_points; ++i) {
+        goal.velocities.col(i) =
+            (goal.positions.col(i + 1) - goal.positions.col(i - 1)) /
+            (goal.times[i + 1] - goal.times[i - 1]);
+      }
+    }
+
+    goal.goal_tolerances =
+        Eigen::VectorXd::Constant(num_joints_, default_goal_tolerance_);
+    for (const control_msgs::JointTolerance& tolerance :
+         handle.getGoal()->goal_tolerance) {
+      const auto it = std::find(joint_names_.begin(), joint_names_.end(),
+                                tolerance.name);
+      if (it == joint_names_.end() || tolerance.position == 0.0) continue;
+      // -1 means "no tolerance".
+      goal.goal_tolerances[it - joint_names_.begin()] =
+          tolerance.position < 0.0 ? std::numeric_limits<double>::infinity()
+                                   : tolerance.position;
+    }
+    goal.goal_time_tolerance =
+        handle.getGoal()->goal_time_tolerance.toSec();
+
+    handle.setAccepted();
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (has_goal_) {
+      control_msgs::FollowJointTrajectoryResult preempted;
+      goal_.handle.setCanceled(preempted, "preempted by a new goal");
+    }
+    goal_ = goal;
+    has_goal_ = true;
+    ++goal_sequence_;
+  }
+
+  // Action thread: the simulation stops the goal at its next step.
+  void HandleCancel(GoalHandle handle) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (has_goal_ && goal_.handle == handle) cancel_sequence_ = goal_sequence_;
+  }
+
+  // Starts newly received goals and stops canceled ones.
+  void DoCalcUnrestrictedUpdate(
+      const systems::Context<double>& context,
+      const std::vector<const systems::UnrestrictedUpdateEvent<double>*>&,
+      systems::State<double>* state) const override {
+    ExecutionState& execution =
+        state->get_mutable_abstract_state()
+            .get_mutable_value(0)
+            .GetMutableValue<ExecutionState>();
+    const double time = context.get_time();
+    const Eigen::VectorXd q =
+        EvalVectorInput(context, 0)->get_value().head(num_joints_);
+    if (execution.hold.size() == 0) execution.hold = q;
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (has_goal_ && goal_sequence_ != execution.sequence) {
+      // The spline starts at the current desired state, unless the goal's
+      // first point is meant for now.
+      const bool from_current = goal_.times[0] > 0.0;
+      const int num_knots =
+          static_cast<int>(goal_.times.size()) + (from_current ? 1 : 0);
+      Eigen::VectorXd breaks(num_knots);
+      Eigen::MatrixXd positions(num_joints_, num_knots);
+      Eigen::MatrixXd velocities(num_joints_, num_knots);
+      if (from_current) {
+        breaks[0] = time;
+        positions.col(0) = DesiredPosition(execution, time);
+        velocities.col(0) = DesiredVelocity(execution, time);
+      }
+      breaks.tail(goal_.times.size()) = goal_.times.array() + time;
+      positions.rightCols(goal_.times.size()) = goal_.positions;
+      velocities.rightCols(goal_.times.size()) = goal_.velocities;
+
+      execution.q_d = trajectories::PiecewisePolynomial<double>::CubicHermite(
+          breaks, positions, velocities);
+      execution.v_d = execution.q_d.derivative(1);
+      execution.hold = goal_.positions.rightCols(1);
+      execution.sequence = goal_sequence_;
+      execution.active = true;
+    }
+    if (execution.active && cancel_sequence_ == execution.sequence) {
+      execution.hold = DesiredPosition(execution, time);
+      execution.active = false;
+    }
+  }
+
+  // Reports feedback and results of the active goal.
+  void DoPublish(
+      const systems::Context<double>& context,
+      const std::vector<const systems::PublishEvent<double>*>&) const override {
+    const ExecutionState& execution =
+        context.get_abstract_state<ExecutionState>(0);
+    const double time = context.get_time();
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!has_goal_ || goal_sequence_ != execution.sequence) return;
+
+    const Eigen::VectorXd measured = EvalVectorInput(context, 0)->get_value();
+    control_msgs::FollowJointTrajectoryResult result;
+    if (!execution.active) {
+      result.error_code = result.SUCCESSFUL;
+      goal_.handle.setCanceled(result, "canceled");
+      has_goal_ = false;
+      return;
+    }
+
+    if (time - last_feedback_time_ >= feedback_period_) {
+      const Eigen::VectorXd q_d = DesiredPosition(execution, time);
+      const Eigen::VectorXd v_d = DesiredVelocity(execution, time);
+      feedback_.header.stamp = ros::Time(time);
+      FillPoint(q_d, v_d, &feedback_.desired);
+      FillPoint(measured.head(num_joints_), measured.tail(num_joints_),
+                &feedback_.actual);
+      FillPoint(q_d - measured.head(num_joints_),
+                v_d - measured.tail(num_joints_), &feedback_.error);
+      goal_.handle.publishFeedback(feedback_);
+      last_feedback_time_ = time;
+    }
+
+    const double end_time = execution.q_d.end_time();
+    if (time < end_time) return;
+    const bool within_tolerance =
+        ((measured.head(num_joints_) - execution.hold).array().abs() <=
+         goal_.goal_tolerances.array())
+            .all();
+    if (within_tolerance) {
+      result.error_code = result.SUCCESSFUL;
+      goal_.handle.setSucceeded(result);
+      has_goal_ = false;
+    } else if (time > end_time + goal_.goal_time_tolerance) {
+      result.error_code = result.GOAL_TOLERANCE_VIOLATED;
+      result.error_string = "goal tolerance violated";
+      goal_.handle.setAborted(result, result.error_string);
+      has_goal_ = false;
+    }
+  }
+
+  void CalcDesiredState(const systems::Context<double>& context,
+                        systems::BasicVector<double>* output) const {
+    const ExecutionState& execution =
+        context.get_abstract_state<ExecutionState>(0);
+    const double time = context.get_time();
+    auto x_d = output->get_mutable_value();
+    if (execution.hold.size() == 0) {
+      // Before the first step: hold the measured position.
+      x_d.head(num_joints_) =
+          EvalVectorInput(context, 0)->get_value().head(num_joints_);
+    } else {
+      x_d.head(num_joints_) = DesiredPosition(execution, time);
+    }
+    x_d.tail(num_joints_) = DesiredVelocity(execution, time);
+  }
+
+  Eigen::VectorXd DesiredPosition(const ExecutionState& execution,
+                                  double time) const {
+    if (!execution.active) return execution.hold;
+    return execution.q_d.value(
+        std::min(std::max(time, execution.q_d.start_time()),
+                 execution.q_d.end_time()));
+  }
+
+  Eigen::VectorXd DesiredVelocity(const ExecutionState& execution,
+                                  double time) const {
+    if (!execution.active || time >= execution.v_d.end_time())
+      return Eigen::VectorXd::Zero(num_joints_);
+    return execution.v_d.value(std::max(time, execution.v_d.start_time()));
+  }
+
+  static void FillPoint(const Eigen::VectorXd& positions,
+                        const Eigen::VectorXd& velocities,
+                        trajectory_msgs::JointTrajectoryPoint* point) {
+    point->positions.assign(positions.data(),
+                            positions.data() + positions.size());
+    point->velocities.assign(velocities.data(),
+                             velocities.data() + velocities.size());
+  }
+
+  const std::vector<std::string> joint_names_;
+  const int num_joints_;
+  const double feedback_period_;
+  const double default_goal_tolerance_;
+
+  // The mutex that guards the goal hand-over below.
+  mutable std::mutex mutex_;
+  mutable Goal goal_;
+  mutable bool has_goal_{false};
+  int goal_sequence_{0};
+  int cancel_sequence_{0};
+
+  // Simulation thread only.
+  mutable double last_feedback_time_{-std::numeric_limits<double>::infinity()};
+  mutable control_msgs::FollowJointTrajectoryFeedback feedback_;
+
+  ros::CallbackQueue callback_queue_;
+  ros::NodeHandle action_node_handle_;
+  std::unique_ptr<ActionServer> server_;
+  std::unique_ptr<ros::AsyncSpinner> spinner_;
+};
+
+}  // namespace drake_ros_systems
@@ -0,0 +1,316 @@
+#pragma once
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "drake/common/drake_copyable.h"
+
+#include "ros/ros.h"
+#include "sensor_msgs/CameraInfo.h"
+#include "sensor_msgs/Image.h"
+#include "sensor_msgs/image_encodings.h"
+
+#include "drake_ros_systems/subscriber_system_base.h"
+
+namespace drake_ros_systems {
+
+using namespace drake;
+
+/**
+ * Receives `sensor_msgs/Image` messages from a given topic and outputs them
+ * to a System<double>'s port, optionally rectified.
+ *
+ * Rectification is enabled with EnableRectification(). The remap lookup
+ * table, mapping every output pixel to a fixed-point source position and four
+ * bilinear weights, is built from `sensor_msgs/CameraInfo` once and only
+ * rebuilt when the calibration changes. Each frame is then remapped on the
+ * ROS callback thread with integer arithmetic only. The `plumb_bob` and
+ * `rational_polynomial` distortion models and all encodings with 8- or
+ * 16-bit unsigned channels are supported; anything else, and frames arriving
+ * before the first `CameraInfo`, are passed through unrectified. Binning and
+ * ROI in `CameraInfo` are not supported.
+ */
+class RosImageSubscriberSystem
+    : public SubscriberSystemBase<sensor_msgs::Image> {
+ public:
+  DRAKE_NO_COPY_NO_MOVE_NO_ASSIGN(RosImageSubscriberSystem)
+
+  /**
+   * @param[in] topic The ROS topic of the images.
+   *
+   * @param node_handle The ROS context.
+   */
+  RosImageSubscriberSystem(const std::string& topic,
+                           ros::NodeHandle* node_handle)
+      : topic_(topic), node_handle_(node_handle) {
+    DRAKE_DEMAND(node_handle_ != nullptr);
+
+    image_subscriber_ = node_handle_->subscribe(
+        topic, 1, &RosImageSubscriberSystem::HandleImage, this);
+
+    set_name(make_name(topic_));
+  }
+
+  ~RosImageSubscriberSystem() override{};
+
+  const std::string& get_topic_name() const { return topic_; }
+
+  /// Returns the default name for a system that subscribes to @p topic.
+  static std::string make_name(const std::string& topic) {
+    return "RosImageSubscriberSystem(" + topic + ")";
+  }
+
+  /**
+   * Rectifies every received image using the calibration published on
+   * @p camera_info_topic. Must be called before the ROS callbacks are being
+   * spun.
+   */
+  void EnableRectification(const std::string& camera_info_topic) {
+    camera_info_subscriber_ = node_handle_->subscribe(
+        camera_info_topic, 1, &RosImageSubscriberSystem::HandleCameraInfo,
+        this);
+  }
+
+ private:
+  // Fractional bits of the fixed-point source positions. Bilinear weights
+  // then sum to 2^(2 * kInterBits), which keeps 16-bit products in 32 bits.
+  static constexpr int kInterBits = 7;
+  static constexpr int kInterScale = 1 << kInterBits;
+  static constexpr int kWeightBits = 2 * kInterBits;
+
+  void HandleCameraInfo(const sensor_msgs::CameraInfo::ConstPtr& info) {
+    std::lock_guard<std::mutex> lock(rectification_mutex_);
+    if (has_camera_info_ && info->width == camera_info_.width &&
+        info->height == camera_info_.height &&
+        info->distortion_model == camera_info_.distortion_model &&
+        info->D == camera_info_.D && info->K == camera_info_.K &&
+        info->R == camera_info_.R && info->P == camera_info_.P) {
+      return;
+    }
+    camera_info_ = *info;
+    has_camera_info_ = true;
+    BuildRemapTable();
+  }
+
+  void HandleImage(const sensor_msgs::Image::ConstPtr& image) {
+    SPDLOG_TRACE(drake::log(), "Receiving ROS {} message", topic_);
+    std::lock_guard<std::mutex> lock(rectification_mutex_);
+    if (!has_remap_table_ || image->width != camera_info_.width ||
+        image->height != camera_info_.height || !Rectify(*image)) {
+      HandleMessage(*image);
+      return;
+    }
+    HandleMessage(&scratch_);
+  }
+
+  // Must be called with rectification_mutex_ held.
+  void BuildRemapTable() {
+    has_remap_table_ = false;
+    const sensor_msgs::CameraInfo& info = camera_info_;
+    const bool rational = info.distortion_model == "rational_polynomial";
+    if (info.distortion_model != "plumb_bob" && !rational) {
+      ROS_WARN("%s: unsupported distortion model '%s', not rectifying",
+               topic_.c_str(), info.distortion_model.c_str());
+      return;
+    }
+    if (info.K[0] == 0.0) return;
+
+    std::array<double, 8> d{};
+    for (std::size_t i = 0; i < d.size() && i < info.D.size(); ++i)
+      d[i] = info.D[i];
+    const double k1 = d[0], k2 = d[1], p1 = d[2], p2 = d[3], k3 = d[4];
+    const double k4 = rational ? d[5] : 0.0;
+    const double k5 = rational ? d[6] : 0.0;
+    const double k6 = rational ? d[7] : 0.0;
+
+    const double fx = info.K[0], cx = info.K[2];
+    const double fy = info.K[4], cy = info.K[5];
+    // The rectified camera; an unset P means rectifying into K.
+    const bool has_p = info.P[0] != 0.0;
+    const double fx_p = has_p ? info.P[0] : fx, cx_p = has_p ? info.P[2] : cx;
+    const double fy_p = has_p ? info.P[5] : fy, cy_p = has_p ? info.P[6] : cy;
+    // Rows of R^T, i.e. the rotation from the rectified to the raw frame. An
+    // unset R means identity.
+    std::array<double, 9> r{{1, 0, 0, 0, 1, 0, 0, 0, 1}};
+    if (info.R[0] != 0.0 || info.R[4] != 0.0 || info.R[8] != 0.0) {
+      for (int i = 0; i < 3; ++i)
+        for (int j = 0; j < 3; ++j) r[3 * i + j] = info.R[3 * j + i];
+    }
+
+    const int width = info.width;
+    const int height = info.height;
+    const std::size_t num_pixels = static_cast<std::size_t>(width) * height;
+    remap_x_.resize(num_pixels);
+    remap_y_.resize(num_pixels);
+    remap_weights_.resize(num_pixels);
+    for (int v = 0; v < height; ++v) {
+      const double y = (v - cy_p) / fy_p;
+      for (int u = 0; u < width; ++u) {
+        const double x = (u - cx_p) / fx_p;
+        const double X = r[0] * x + r[1] * y + r[2];
+        const double Y = r[3] * x + r[4] * y + r[5];
+        const double W = r[6] * x + r[7] * y + r[8];
+        const double xn = X / W;
+        const double yn = Y / W;
+        const double r2 = xn * xn + yn * yn;
+        const double r4 = r2 * r2;
+        const double r6 = r4 * r2;
+        const double radial = (1.0 + k1 * r2 + k2 * r4 + k3 * r6) /
+                              (1.0 + k4 * r2 + k5 * r4 + k6 * r6);
+        const double xd =
+            xn * radial + 2.0 * p1 * xn * yn + p2 * (r2 + 2.0 * xn * xn);
+        const double yd =
+            yn * radial + p1 * (r2 + 2.0 * yn * yn) + 2.0 * p2 * xn * yn;
+        const double map_x = fx * xd + cx;
+        const double map_y = fy * yd + cy;
+
+        const std::size_t index = static_cast<std::size_t>(v) * width + u;
+        const long fixed_x = std::lround(map_x * kInterScale);
+        const long fixed_y = std::lround(map_y * kInterScale);
+        long x0 = fixed_x >> kInterBits;
+        long y0 = fixed_y >> kInterBits;
+        if (x0 < 0 || y0 < 0 || x0 >= width || y0 >= height || width < 2 ||
+            height < 2) {
+          // Outside of the raw image; rendered black.
+          remap_x_[index] = -1;
+          remap_y_[index] = -1;
+          continue;
+        }
+        int ax = static_cast<int>(fixed_x & (kInterScale - 1));
+        int ay = static_cast<int>(fixed_y & (kInterScale - 1));
+        // On the last column or row the missing neighbour is clamped to the
+        // edge pixel, expressed as the edge pixel being the right or bottom
+        // neighbour with full weight, so that all four reads stay inside.
+        if (x0 == width - 1) {
+          --x0;
+          ax = kInterScale;
+        }
+        if (y0 == height - 1) {
+          --y0;
+          ay = kInterScale;
+        }
+        remap_x_[index] = static_cast<std::int32_t>(x0);
+        remap_y_[index] = static_cast<std::int32_t>(y0);
+        const int bx = kInterScale - ax;
+        const int by = kInterScale - ay;
+        remap_weights_[index] = {{static_cast<std::uint16_t>(bx * by),
+                                  static_cast<std::uint16_t>(ax * by),
+                                  static_cast<std::uint16_t>(bx * ay),
+                                  static_cast<std::uint16_t>(ax * ay)}};
+      }
+    }
+    has_remap_table_ = true;
+  }
+
+  // Remaps @p image into scratch_. Returns false if the encoding is not
+  // supported. Must be called with rectification_mutex_ held.
+  bool Rectify(const sensor_msgs::Image& image) {
+    namespace enc = sensor_msgs::image_encodings;
+    // bitDepth() and numChannels() throw on encodings they do not know, such
+    // as yuv422 or custom ones; Bayer patterns are known but not remappable.
+    if (!enc::isColor(image.encoding) && !enc::isMono(image.encoding) &&
+        !enc::hasChannelInfo(image.encoding)) {
+      return false;
+    }
+    const int bit_depth = enc::bitDepth(image.encoding);
+    const int channels = enc::numChannels(image.encoding);
+    if ((bit_depth != 8 && bit_depth != 16) || channels < 1 ||
+        (bit_depth == 16 && image.is_bigendian)) {
+      return false;
+    }
+    const std::size_t row_size =
+        static_cast<std::size_t>(image.width) * channels * bit_depth / 8;
+    if (image.step < row_size ||
+        image.data.size() <
+            static_cast<std::size_t>(image.height) * image.step) {
+      return false;
+    }
+
+    scratch_.header = image.header;
+    scratch_.width = image.width;
+    scratch_.height = image.height;
+    scratch_.encoding = image.encoding;
+    scratch_.is_bigendian = image.is_bigendian;
+    scratch_.step = row_size;
+    scratch_.data.resize(row_size * image.height);
+
+    if (bit_depth == 8) {
+      Remap<std::uint8_t>(image, channels);
+    } else {
+      Remap<std::uint16_t>(image, channels);
+    }
+    return true;
+  }
+
+  // A scalar loop: every output pixel gathers four source pixels at
+  // arbitrary offsets, and blends at most four channels each.
+  template <typename Channel>
+  void Remap(const sensor_msgs::Image& image, int channels) {
+    const int width = image.width;
+    const std::size_t source_step = image.step / sizeof(Channel);
+    const Channel* const source =
+        reinterpret_cast<const Channel*>(image.data.data());
+    Channel* const destination =
+        reinterpret_cast<Channel*>(scratch_.data.data());
+    const std::uint32_t kRound = 1u << (kWeightBits - 1);
+
+    for (std::size_t v = 0; v < image.height; ++v) {
+      for (int u = 0; u < width; ++u) {
+        const std::size_t index = v * width + u;
+        Channel* const out = destination + index * channels;
+        const std::int32_t x0 = remap_x_[index];
+        if (x0 < 0) {
+          for (int c = 0; c < channels; ++c) out[c] = 0;
+          continue;
+        }
+        const std::int32_t y0 = remap_y_[index];
+        const Channel* const p00 = source + y0 * source_step + x0 * channels;
+        const Channel* const p10 = p00 + source_step;
+        const std::array<std::uint16_t, 4>& w = remap_weights_[index];
+        for (int c = 0; c < channels; ++c) {
+          const std::uint32_t value =
+              w[0] * std::uint32_t{p00[c]} +
+              w[1] * std::uint32_t{p00[c + channels]} +
+              w[2] * std::uint32_t{p10[c]} +
+              w[3] * std::uint32_t{p10[c + channels]};
+          out[c] = static_cast<Channel>((value + kRound) >> kWeightBits);
+        }
+      }
+    }
+  }
+
+  // The topic on which to receive images.
+  const std::string topic_;
+
+  ros::NodeHandle* const node_handle_{};
+
+  // The mutex that guards everything below; the two subscriptions may be
+  // serviced by different spinner threads.
+  std::mutex rectification_mutex_;
+
+  // The calibration remap_x_, remap_y_ and remap_weights_ were built from.
+  sensor_msgs::CameraInfo camera_info_;
+  bool has_camera_info_{false};
+  bool has_remap_table_{false};
+
+  // For every output pixel, the top-left raw source pixel of its bilinear
+  // neighbourhood (-1 if outside of the raw image), and the weights of the
+  // top-left, top-right, bottom-left and bottom-right pixels.
+  std::vector<std::int32_t> remap_x_;
+  std::vector<std::int32_t> remap_y_;
+  std::vector<std::array<std::uint16_t, 4>> remap_weights_;
+
+  // The image being filled; swapped with the receive buffer once complete.
+  sensor_msgs::Image scratch_;
+
+  ros::Subscriber image_subscriber_;
+  ros::Subscriber camera_info_subscriber_;
+};
+
+}  // namespace drake_ros_systems
@@ -0,0 +1,133 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "drake/common/drake_copyable.h"
+#include "drake/systems/framework/leaf_system.h"
+
+#include "ros/ros.h"
+#include "sensor_msgs/LaserScan.h"
+
+namespace drake_ros_systems {
+
+using namespace drake;
+
+/**
+ * Geometry of the scans published by RosLaserScanPublisherSystem, matching
+ * the fields of `sensor_msgs/LaserScan`.
+ */
+struct LaserScanSpecification {
+  std::string frame_id;
+  int num_beams{0};
+  double angle_min{0.0};
+  double angle_max{0.0};
+  double range_min{0.0};
+  double range_max{0.0};
+  /// Time between two scans; zero if unknown.
+  double scan_time{0.0};
+};
+
+/**
+ * Publishes `sensor_msgs/LaserScan` messages built from the beam ranges on
+ * its sole vector-valued input port, e.g. the distances output by a Drake
+ * ray-casting depth sensor.
+ *
+ * The message is allocated once with the static fields of the
+ * LaserScanSpecification filled in; every publish only stamps it with the
+ * context time and copies the ranges into it.
+ */
+class RosLaserScanPublisherSystem : public systems::LeafSystem<double> {
+ public:
+  DRAKE_NO_COPY_NO_MOVE_NO_ASSIGN(RosLaserScanPublisherSystem)
+
+  /**
+   * @param[in] topic The ROS topic on which to publish.
+   *
+   * @param[in] spec The geometry of the scans. Its `num_beams` is the size
+   * of the input port.
+   *
+   * @param node_handle The ROS context.
+   */
+  RosLaserScanPublisherSystem(const std::string& topic,
+                              const LaserScanSpecification& spec,
+                              ros::NodeHandle* node_handle)
+      : topic_(topic), node_handle_(node_handle) {
+    DRAKE_DEMAND(node_handle_ != nullptr);
+    DRAKE_DEMAND(spec.num_beams > 0);
+
+    publisher_ = node_handle_->advertise<sensor_msgs::LaserScan>(topic, 1);
+
+    message_.header.frame_id = spec.frame_id;
+    message_.angle_min = spec.angle_min;
+    message_.angle_max = spec.angle_max;
+    message_.angle_increment =
+        spec.num_beams > 1
+            ? (spec.angle_max - spec.angle_min) / (spec.num_beams - 1)
+            : 0.0;
+    message_.scan_time = spec.scan_time;
+    message_.time_increment =
+        spec.num_beams > 1 ? spec.scan_time / (spec.num_beams - 1) : 0.0;
+    message_.range_min = spec.range_min;
+    message_.range_max = spec.range_max;
+    message_.ranges.resize(spec.num_beams);
+
+    DeclareInputPort(systems::kVectorValued, spec.num_beams);
+    set_name(make_name(topic_));
+  }
+
+  ~RosLaserScanPublisherSystem() override{};
+
+  const std::string& get_topic_name() const { return topic_; }
+
+  /// Returns the default name for a system that publishes @p topic.
+  static std::string make_name(const std::string& topic) {
+    return "RosLaserScanPublisherSystem(" + topic + ")";
+  }
+
+  /**
+   * Sets the publishing period of this system. See
+   * LeafSystem::DeclarePublishPeriodSec() for details about the semantics of
+   * parameter `period`.
+   */
+  void set_publish_period(double period) {
+    LeafSystem<double>::DeclarePeriodicPublish(period);
+  }
+
+  /**
+   * Copies the ranges from the input port of the context into the reused
+   * message and publishes it onto a ROS topic.
+   */
+  void DoPublish(
+      const systems::Context<double>& context,
+      const std::vector<const systems::PublishEvent<double>*>&) const override {
+    SPDLOG_TRACE(drake::log(), "Publishing ROS {} message", topic_);
+
+    const systems::BasicVector<double>* const ranges =
+        this->EvalVectorInput(context, kPortIndex);
+    DRAKE_ASSERT(ranges != nullptr);
+
+    message_.header.stamp = ros::Time(context.get_time());
+    const int num_beams = static_cast<int>(message_.ranges.size());
+    for (int i = 0; i < num_beams; ++i)
+      message_.ranges[i] = static_cast<float>(ranges->GetAtIndex(i));
+
+    // Serialized straight from the member, without an intermediate copy.
+    publisher_.publish(message_);
+  }
+
+ private:
+  // The topic on which to publish scans.
+  const std::string topic_;
+
+  ros::NodeHandle* const node_handle_{};
+  ros::Publisher publisher_;
+
+  // The message reused by every publish.
+  mutable sensor_msgs::LaserScan message_;
+
+  const int kPortIndex = 0;
+};
+
+}  // namespace drake_ros_systems
@@ -0,0 +1,118 @@
+#pragma once
+
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include <Eigen/Core>
+
+#include "drake/common/drake_copyable.h"
+#include "drake/perception/point_cloud.h"
+
+#include "ros/ros.h"
+#include "sensor_msgs/LaserScan.h"
+
+#include "drake_ros_systems/subscriber_system_base.h"
+
+namespace drake_ros_systems {
+
+using namespace drake;
+
+/**
+ * Receives `sensor_msgs/LaserScan` messages and outputs them converted into a
+ * perception::PointCloud in the scan's frame, one point per beam.
+ *
+ * The cosine and sine of every beam angle are cached per scan signature
+ * (`angle_min`, `angle_increment`, beam count) and only recomputed when the
+ * signature changes; each scan is then converted in one batch of vectorized
+ * Eigen array operations on the ROS callback thread. Beams whose range is not
+ * finite or lies outside of [`range_min`, `range_max`] produce NaN points.
+ */
+class RosLaserScanSubscriberSystem
+    : public SubscriberSystemBase<perception::PointCloud> {
+ public:
+  DRAKE_NO_COPY_NO_MOVE_NO_ASSIGN(RosLaserScanSubscriberSystem)
+
+  /**
+   * @param[in] topic The ROS topic of the scans.
+   *
+   * @param node_handle The ROS context.
+   */
+  RosLaserScanSubscriberSystem(const std::string& topic,
+                               ros::NodeHandle* node_handle)
+      : topic_(topic), node_handle_(node_handle) {
+    DRAKE_DEMAND(node_handle_ != nullptr);
+
+    subscriber_ = node_handle_->subscribe(
+        topic, 10, &RosLaserScanSubscriberSystem::HandleScan, this);
+
+    set_name(make_name(topic_));
+  }
+
+  ~RosLaserScanSubscriberSystem() override{};
+
+  const std::string& get_topic_name() const { return topic_; }
+
+  /// Returns the default name for a system that subscribes to @p topic.
+  static std::string make_name(const std::string& topic) {
+    return "RosLaserScanSubscriberSystem(" + topic + ")";
+  }
+
+ private:
+  void HandleScan(const sensor_msgs::LaserScan::ConstPtr& scan) {
+    SPDLOG_TRACE(drake::log(), "Receiving ROS {} message", topic_);
+    std::lock_guard<std::mutex> lock(conversion_mutex_);
+    const int num_beams = static_cast<int>(scan->ranges.size());
+    if (num_beams != cos_.size() || scan->angle_min != angle_min_ ||
+        scan->angle_increment != angle_increment_) {
+      angle_min_ = scan->angle_min;
+      angle_increment_ = scan->angle_increment;
+      const Eigen::ArrayXf angles =
+          angle_min_ +
+          angle_increment_ * Eigen::ArrayXf::LinSpaced(num_beams, 0,
+                                                        num_beams - 1);
+      cos_ = angles.cos();
+      sin_ = angles.sin();
+    }
+
+    const Eigen::Map<const Eigen::ArrayXf> ranges(scan->ranges.data(),
+                                                  num_beams);
+    const float kNaN = std::numeric_limits<float>::quiet_NaN();
+    r_ = (ranges >= scan->range_min && ranges <= scan->range_max)
+             .select(ranges, kNaN);
+
+    if (scratch_.size() != num_beams) scratch_.resize(num_beams);
+    auto xyzs = scratch_.mutable_xyzs();
+    xyzs.row(0) = (r_ * cos_).matrix().transpose();
+    xyzs.row(1) = (r_ * sin_).matrix().transpose();
+    xyzs.row(2) = (r_ * 0.0f).matrix().transpose();
+
+    HandleMessage(&scratch_);
+  }
+
+  // The topic on which to receive scans.
+  const std::string topic_;
+
+  ros::NodeHandle* const node_handle_{};
+
+  // The mutex that guards everything below.
+  std::mutex conversion_mutex_;
+
+  // The angle tables and the signature they were computed for.
+  float angle_min_{0.0f};
+  float angle_increment_{0.0f};
+  Eigen::ArrayXf cos_;
+  Eigen::ArrayXf sin_;
+
+  // Validated ranges of the scan being converted.
+  Eigen::ArrayXf r_;
+
+  // The cloud being filled; swapped with the receive buffer once complete.
+  perception::PointCloud scratch_;
+
+  ros::Subscriber subscriber_;
+};
+
+}  // namespace drake_ros_systems
@@ -0,0 +1,286 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <Eigen/Geometry>
+
+#include "drake/common/drake_copyable.h"
+#include "drake/multibody/math/spatial_acceleration.h"
+#include "drake/multibody/math/spatial_force.h"
+#include "drake/multibody/math/spatial_velocity.h"
+#include "drake/multibody/plant/multibody_plant.h"
+#include "drake/systems/framework/leaf_system.h"
+
+#include "geometry_msgs/WrenchStamped.h"
+#include "nav_msgs/Odometry.h"
+#include "ros/ros.h"
+#include "sensor_msgs/Imu.h"
+
+namespace drake_ros_systems {
+
+using namespace drake;
+
+/**
+ * Publishes simulated IMU, odometry and joint wrench sensors of a
+ * multibody::MultibodyPlant, all from one system and in one publish event.
+ *
+ * The plant's state, generalized accelerations and joint reaction forces
+ * come in on three input ports, to be connected to the matching plant output
+ * ports; the last two only need to be connected if IMUs, respectively
+ * wrench sensors, are added. On every publish, the state is loaded into a
+ * private plant Context once, so the poses and velocities of all bodies are
+ * computed in one kinematics pass and reused by every sensor, and all body
+ * accelerations are computed together from the generalized accelerations.
+ * Each sensor's message is preallocated and refilled in place.
+ *
+ * Messages are stamped with the simulation time and use ROS conventions:
+ * IMUs report orientation in the world frame, angular velocity and proper
+ * acceleration (gravity included) in the sensor frame; odometry reports the
+ * body pose in the world frame and its twist in the body frame; wrench
+ * sensors report the reaction force on the joint's child body as output by
+ * the plant, i.e. at and expressed in the joint's child frame.
+ *
+ * The private Context lives outside of the system's Context, so a system
+ * instance must only be simulated in one Context at a time.
+ */
+class RosMultibodySensorPublisherSystem : public systems::LeafSystem<double> {
+ public:
+  DRAKE_NO_COPY_NO_MOVE_NO_ASSIGN(RosMultibodySensorPublisherSystem)
+
+  /**
+   * @param[in] plant The finalized plant whose sensors are simulated. Must
+   * outlive this system.
+   *
+   * @param node_handle The ROS context.
+   *
+   * @param[in] publish_period The period of the publish event, in seconds.
+   */
+  RosMultibodySensorPublisherSystem(
+      const multibody::MultibodyPlant<double>& plant,
+      ros::NodeHandle* node_handle, double publish_period)
+      : plant_(plant),
+        node_handle_(node_handle),
+        plant_context_(plant.CreateDefaultContext()) {
+    DRAKE_DEMAND(node_handle_ != nullptr);
+    DRAKE_DEMAND(plant_.is_finalized());
+
+    state_port_index_ =
+        DeclareInputPort(systems::kVectorValued, plant_.num_multibody_states())
+            .get_index();
+    acceleration_port_index_ =
+        DeclareInputPort(systems::kVectorValued, plant_.num_velocities())
+            .get_index();
+    reaction_forces_port_index_ = DeclareAbstractInputPort().get_index();
+
+    DeclarePeriodicPublish(publish_period);
+    set_name("RosMultibodySensorPublisherSystem");
+  }
+
+  ~RosMultibodySensorPublisherSystem() override{};
+
+  /// Input port for the plant's state, see
+  /// MultibodyPlant::get_state_output_port().
+  const systems::InputPort<double>& get_state_input_port() const {
+    return get_input_port(state_port_index_);
+  }
+
+  /// Input port for the plant's generalized accelerations, see
+  /// MultibodyPlant::get_generalized_acceleration_output_port().
+  const systems::InputPort<double>&
+  get_generalized_acceleration_input_port() const {
+    return get_input_port(acceleration_port_index_);
+  }
+
+  /// Input port for the plant's joint reaction forces, see
+  /// MultibodyPlant::get_reaction_forces_output_port().
+  const systems::InputPort<double>& get_reaction_forces_input_port() const {
+    return get_input_port(reaction_forces_port_index_);
+  }
+
+  /**
+   * Adds an IMU rigidly attached to @p body at pose @p X_BS, publishing
+   * `sensor_msgs/Imu` on @p topic with header frame @p frame_id.
+   */
+  void AddImu(const std::string& topic, const multibody::Body<double>& body,
+              const std::string& frame_id,
+              const Eigen::Isometry3d& X_BS = Eigen::Isometry3d::Identity()) {
+    imus_.push_back(Imu{body.index(), X_BS.linear(), X_BS.translation(),
+                        node_handle_->advertise<sensor_msgs::Imu>(topic, 10),
+                        sensor_msgs::Imu{}});
+    imus_.back().message.header.frame_id = frame_id;
+  }
+
+  /**
+   * Adds an odometry sensor of @p body, publishing `nav_msgs/Odometry` on
+   * @p topic, with the world frame named @p frame_id and the body frame
+   * named @p child_frame_id.
+   */
+  void AddOdometry(const std::string& topic,
+                   const multibody::Body<double>& body,
+                   const std::string& frame_id,
+                   const std::string& child_frame_id) {
+    odometries_.push_back(
+        Odometry{body.index(),
+                 node_handle_->advertise<nav_msgs::Odometry>(topic, 10),
+                 nav_msgs::Odometry{}});
+    odometries_.back().message.header.frame_id = frame_id;
+    odometries_.back().message.child_frame_id = child_frame_id;
+  }
+
+  /**
+   * Adds a wrench sensor measuring the reaction force in @p joint,
+   * publishing `geometry_msgs/WrenchStamped` on @p topic with header frame
+   * @p frame_id, which should name the joint's child frame.
+   */
+  void AddWrench(const std::string& topic,
+                 const multibody::Joint<double>& joint,
+                 const std::string& frame_id) {
+    wrenches_.push_back(Wrench{
+        joint.index(),
+        node_handle_->advertise<geometry_msgs::WrenchStamped>(topic, 10),
+        geometry_msgs::WrenchStamped{}});
+    wrenches_.back().message.header.frame_id = frame_id;
+  }
+
+  /// Fills and publishes the messages of all sensors.
+  void DoPublish(
+      const systems::Context<double>& context,
+      const std::vector<const systems::PublishEvent<double>*>&) const override {
+    const ros::Time stamp(context.get_time());
+    plant_.SetPositionsAndVelocities(
+        plant_context_.get(),
+        EvalVectorInput(context, state_port_index_)->get_value());
+
+    if (!imus_.empty()) {
+      const systems::BasicVector<double>* vdot =
+          EvalVectorInput(context, acceleration_port_index_);
+      DRAKE_DEMAND(vdot != nullptr);
+      accelerations_.resize(plant_.num_bodies());
+      plant_.CalcSpatialAccelerationsFromVdot(*plant_context_,
+                                              vdot->get_value(),
+                                              &accelerations_);
+      const Eigen::Vector3d g_W = plant_.gravity_field().gravity_vector();
+      for (Imu& imu : imus_) FillImu(stamp, g_W, &imu);
+    }
+
+    for (Odometry& odometry : odometries_) FillOdometry(stamp, &odometry);
+
+    if (!wrenches_.empty()) {
+      const systems::AbstractValue* input =
+          EvalAbstractInput(context, reaction_forces_port_index_);
+      DRAKE_DEMAND(input != nullptr);
+      const auto& forces =
+          input->GetValue<std::vector<multibody::SpatialForce<double>>>();
+      for (Wrench& wrench : wrenches_) {
+        const multibody::SpatialForce<double>& F = forces[wrench.joint];
+        wrench.message.header.stamp = stamp;
+        SetVector(F.translational(), &wrench.message.wrench.force);
+        SetVector(F.rotational(), &wrench.message.wrench.torque);
+      }
+    }
+
+    // Everything is filled before anything goes out, so all sensors of a
+    // publish event are consistent.
+    for (const Imu& imu : imus_) imu.publisher.publish(imu.message);
+    for (const Odometry& odometry : odometries_)
+      odometry.publisher.publish(odometry.message);
+    for (const Wrench& wrench : wrenches_)
+      wrench.publisher.publish(wrench.message);
+  }
+
+ private:
+  struct Imu {
+    multibody::BodyIndex body;
+    // X_BS, kept apart to avoid aligned storage.
+    Eigen::Matrix3d R_BS;
+    Eigen::Vector3d p_BS;
+    ros::Publisher publisher;
+    sensor_msgs::Imu message;
+  };
+
+  struct Odometry {
+    multibody::BodyIndex body;
+    ros::Publisher publisher;
+    nav_msgs::Odometry message;
+  };
+
+  struct Wrench {
+    multibody::JointIndex joint;
+    ros::Publisher publisher;
+    geometry_msgs::WrenchStamped message;
+  };
+
+  void FillImu(const ros::Time& stamp, const Eigen::Vector3d& g_W,
+               Imu* imu) const {
+    const multibody::Body<double>& body = plant_.get_body(imu->body);
+    const Eigen::Isometry3d X_WB =
+        plant_.EvalBodyPoseInWorld(*plant_context_, body).GetAsIsometry3();
+    const Eigen::Matrix3d R_WS = X_WB.linear() * imu->R_BS;
+    const Eigen::Vector3d p_BS_W = X_WB.linear() * imu->p_BS;
+    const multibody::SpatialVelocity<double>& V_WB =
+        plant_.EvalBodySpatialVelocityInWorld(*plant_context_, body);
+    const multibody::SpatialAcceleration<double> A_WS =
+        accelerations_[imu->body].Shift(p_BS_W, V_WB.rotational());
+
+    sensor_msgs::Imu& message = imu->message;
+    message.header.stamp = stamp;
+    SetQuaternion(Eigen::Quaterniond(R_WS), &message.orientation);
+    SetVector(R_WS.transpose() * V_WB.rotational(),
+              &message.angular_velocity);
+    // An accelerometer measures its acceleration relative to free fall.
+    SetVector(R_WS.transpose() * (A_WS.translational() - g_W),
+              &message.linear_acceleration);
+  }
+
+  void FillOdometry(const ros::Time& stamp, Odometry* odometry) const {
+    const multibody::Body<double>& body = plant_.get_body(odometry->body);
+    const Eigen::Isometry3d X_WB =
+        plant_.EvalBodyPoseInWorld(*plant_context_, body).GetAsIsometry3();
+    const multibody::SpatialVelocity<double>& V_WB =
+        plant_.EvalBodySpatialVelocityInWorld(*plant_context_, body);
+    const Eigen::Matrix3d R_BW = X_WB.linear().transpose();
+
+    nav_msgs::Odometry& message = odometry->message;
+    message.header.stamp = stamp;
+    SetVector(X_WB.translation(), &message.pose.pose.position);
+    SetQuaternion(Eigen::Quaterniond(X_WB.linear()),
+                  &message.pose.pose.orientation);
+    SetVector(R_BW * V_WB.translational(), &message.twist.twist.linear);
+    SetVector(R_BW * V_WB.rotational(), &message.twist.twist.angular);
+  }
+
+  template <typename Vector3Message>
+  static void SetVector(const Eigen::Vector3d& v, Vector3Message* out) {
+    out->x = v.x();
+    out->y = v.y();
+    out->z = v.z();
+  }
+
+  template <typename QuaternionMessage>
+  static void SetQuaternion(const Eigen::Quaterniond& q,
+                            QuaternionMessage* out) {
+    out->w = q.w();
+    out->x = q.x();
+    out->y = q.y();
+    out->z = q.z();
+  }
+
+  const multibody::MultibodyPlant<double>& plant_;
+  ros::NodeHandle* const node_handle_{};
+
+  int state_port_index_{};
+  int acceleration_port_index_{};
+  int reaction_forces_port_index_{};
+
+  // Scratch space reused by every publish.
+  const std::unique_ptr<systems::Context<double>> plant_context_;
+  mutable std::vector<multibody::SpatialAcceleration<double>> accelerations_;
+
+  mutable std::vector<Imu> imus_;
+  mutable std::vector<Odometry> odometries_;
+  mutable std::vector<Wrench> wrenches_;
+};
+
+}  // namespace drake_ros_systems
@@ -0,0 +1,223 @@
+#pragma once
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "drake/common/drake_copyable.h"
+#include "drake/systems/framework/leaf_system.h"
+
+#include "map_msgs/OccupancyGridUpdate.h"
+#include "nav_msgs/OccupancyGrid.h"
+#include "ros/ros.h"
+
+namespace drake_ros_systems {
+
+using namespace drake;
+
+/**
+ * Publishes the `nav_msgs/OccupancyGrid` on its sole abstract-valued input
+ * port incrementally: only the regions that changed since the last publish
+ * are sent, as `map_msgs/OccupancyGridUpdate` patches on `<topic>_updates`
+ * (the map_server / costmap_2d convention). A full grid is sent on `<topic>`
+ * first, whenever the grid geometry changes, when the changes cover most of
+ * the grid, and every `keyframe_interval` publishes, so subscribers that
+ * join late or lose a patch recover. RosOccupancyGridSubscriberSystem
+ * reassembles the stream.
+ *
+ * Changes are found by comparing square tiles against the last sent grid.
+ * Within each band of tile rows, horizontally adjacent dirty tiles are sent
+ * as one patch.
+ */
+class RosOccupancyGridPublisherSystem : public systems::LeafSystem<double> {
+ public:
+  DRAKE_NO_COPY_NO_MOVE_NO_ASSIGN(RosOccupancyGridPublisherSystem)
+
+  /**
+   * @param[in] topic The ROS topic of the full grids; patches go to
+   * `<topic>_updates`.
+   *
+   * @param node_handle The ROS context.
+   *
+   * @param[in] keyframe_interval Number of publishes between full grids.
+   *
+   * @param[in] tile_size Edge length, in cells, of the tiles that are
+   * compared.
+   */
+  RosOccupancyGridPublisherSystem(const std::string& topic,
+                                  ros::NodeHandle* node_handle,
+                                  int keyframe_interval = 100,
+                                  int tile_size = 32)
+      : topic_(topic),
+        node_handle_(node_handle),
+        keyframe_interval_(keyframe_interval),
+        tile_size_(tile_size) {
+    DRAKE_DEMAND(node_handle_ != nullptr);
+    DRAKE_DEMAND(keyframe_interval_ >= 1);
+    DRAKE_DEMAND(tile_size_ >= 1);
+
+    // Latched, so that a late subscriber starts from the last full grid.
+    grid_publisher_ =
+        node_handle_->advertise<nav_msgs::OccupancyGrid>(topic, 1, true);
+    update_publisher_ = node_handle_->advertise<map_msgs::OccupancyGridUpdate>(
+        topic + "_updates", 10);
+
+    DeclareAbstractInputPort();
+    set_name(make_name(topic_));
+  }
+
+  ~RosOccupancyGridPublisherSystem() override{};
+
+  const std::string& get_topic_name() const { return topic_; }
+
+  /// Returns the default name for a system that publishes @p topic.
+  static std::string make_name(const std::string& topic) {
+    return "RosOccupancyGridPublisherSystem(" + topic + ")";
+  }
+
+  /**
+   * Sets the publishing period of this system. See
+   * LeafSystem::DeclarePublishPeriodSec() for details about the semantics of
+   * parameter `period`.
+   */
+  void set_publish_period(double period) {
+    LeafSystem<double>::DeclarePeriodicPublish(period);
+  }
+
+  /**
+   * Diffs the grid from the input port of the context against the last sent
+   * one and publishes either the changed regions or a full grid.
+   */
+  void DoPublish(
+      const systems::Context<double>& context,
+      const std::vector<const systems::PublishEvent<double>*>&) const override {
+    SPDLOG_TRACE(drake::log(), "Publishing ROS {} message", topic_);
+
+    const systems::AbstractValue* const input_value =
+        this->EvalAbstractInput(context, kPortIndex);
+    DRAKE_ASSERT(input_value != nullptr);
+    const nav_msgs::OccupancyGrid& grid =
+        input_value->GetValue<nav_msgs::OccupancyGrid>();
+    const int width = grid.info.width;
+    const int height = grid.info.height;
+    DRAKE_DEMAND(grid.data.size() == static_cast<size_t>(width) * height);
+
+    if (!has_last_sent_ ||
+        publishes_since_keyframe_ + 1 >= keyframe_interval_ ||
+        !HasSameGeometry(grid, last_sent_)) {
+      PublishKeyframe(grid);
+      return;
+    }
+
+    // Collect the patches first, so that a mostly changed grid can still be
+    // sent as a keyframe instead.
+    patches_.clear();
+    int dirty_cells = 0;
+    for (int y0 = 0; y0 < height; y0 += tile_size_) {
+      const int y1 = std::min(y0 + tile_size_, height);
+      int run_start = -1;
+      for (int x0 = 0; x0 <= width; x0 += tile_size_) {
+        const bool dirty = x0 < width && IsTileDirty(grid, x0, y0, y1);
+        if (dirty && run_start < 0) run_start = x0;
+        if (!dirty && run_start >= 0) {
+          const int x1 = std::min(x0, width);
+          patches_.push_back(Patch{run_start, y0, x1 - run_start, y1 - y0});
+          dirty_cells += (x1 - run_start) * (y1 - y0);
+          run_start = -1;
+        }
+      }
+    }
+    if (2 * dirty_cells > width * height) {
+      PublishKeyframe(grid);
+      return;
+    }
+
+    ++publishes_since_keyframe_;
+    update_.header.stamp = ros::Time(context.get_time());
+    update_.header.frame_id = grid.header.frame_id;
+    for (const Patch& patch : patches_) {
+      update_.x = patch.x;
+      update_.y = patch.y;
+      update_.width = patch.width;
+      update_.height = patch.height;
+      update_.data.resize(static_cast<size_t>(patch.width) * patch.height);
+      for (int row = 0; row < patch.height; ++row) {
+        const size_t offset =
+            static_cast<size_t>(patch.y + row) * width + patch.x;
+        std::memcpy(&update_.data[row * patch.width], &grid.data[offset],
+                    patch.width);
+        std::memcpy(&last_sent_.data[offset], &grid.data[offset],
+                    patch.width);
+      }
+      update_publisher_.publish(update_);
+    }
+  }
+
+ private:
+  struct Patch {
+    int x;
+    int y;
+    int width;
+    int height;
+  };
+
+  static bool HasSameGeometry(const nav_msgs::OccupancyGrid& a,
+                              const nav_msgs::OccupancyGrid& b) {
+    const geometry_msgs::Pose& pa = a.info.origin;
+    const geometry_msgs::Pose& pb = b.info.origin;
+    return a.info.width == b.info.width && a.info.height == b.info.height &&
+           a.info.resolution == b.info.resolution &&
+           a.header.frame_id == b.header.frame_id &&
+           pa.position.x == pb.position.x && pa.position.y == pb.position.y &&
+           pa.position.z == pb.position.z &&
+           pa.orientation.x == pb.orientation.x &&
+           pa.orientation.y == pb.orientation.y &&
+           pa.orientation.z == pb.orientation.z &&
+           pa.orientation.w == pb.orientation.w;
+  }
+
+  bool IsTileDirty(const nav_msgs::OccupancyGrid& grid, int x0, int y0,
+                   int y1) const {
+    const int width = grid.info.width;
+    const int tile_width = std::min(tile_size_, width - x0);
+    for (int y = y0; y < y1; ++y) {
+      const size_t offset = static_cast<size_t>(y) * width + x0;
+      if (std::memcmp(&grid.data[offset], &last_sent_.data[offset],
+                      tile_width) != 0)
+        return true;
+    }
+    return false;
+  }
+
+  void PublishKeyframe(const nav_msgs::OccupancyGrid& grid) const {
+    grid_publisher_.publish(grid);
+    last_sent_ = grid;
+    has_last_sent_ = true;
+    publishes_since_keyframe_ = 0;
+  }
+
+  // The topic on which to publish full grids.
+  const std::string topic_;
+
+  ros::NodeHandle* const node_handle_{};
+  ros::Publisher grid_publisher_;
+  ros::Publisher update_publisher_;
+
+  const int keyframe_interval_;
+  const int tile_size_;
+
+  // The grid as subscribers have it after the last publish.
+  mutable nav_msgs::OccupancyGrid last_sent_;
+  mutable bool has_last_sent_{false};
+  mutable int publishes_since_keyframe_{0};
+
+  // Scratch buffers reused by every publish.
+  mutable std::vector<Patch> patches_;
+  mutable map_msgs::OccupancyGridUpdate update_;
+
+  const int kPortIndex = 0;
+};
+
+}  // namespace drake_ros_systems
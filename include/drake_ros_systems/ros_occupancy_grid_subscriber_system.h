@@ -0,0 +1,106 @@
+#pragma once
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <string>
+
+#include "drake/common/drake_copyable.h"
+
+#include "map_msgs/OccupancyGridUpdate.h"
+#include "nav_msgs/OccupancyGrid.h"
+#include "ros/ros.h"
+
+#include "drake_ros_systems/subscriber_system_base.h"
+
+namespace drake_ros_systems {
+
+using namespace drake;
+
+/**
+ * Receives an incrementally published `nav_msgs/OccupancyGrid`, as sent by
+ * RosOccupancyGridPublisherSystem or map_server / costmap_2d, and outputs
+ * the reassembled grid.
+ *
+ * Full grids arrive on `<topic>` and are swapped into the receive buffer;
+ * `map_msgs/OccupancyGridUpdate` patches on `<topic>_updates` are copied
+ * into the receive buffer in place, row by row, so a patch costs its own
+ * size only. Patches arriving before the first full grid, or not fitting
+ * into it, are dropped.
+ */
+class RosOccupancyGridSubscriberSystem
+    : public SubscriberSystemBase<nav_msgs::OccupancyGrid> {
+ public:
+  DRAKE_NO_COPY_NO_MOVE_NO_ASSIGN(RosOccupancyGridSubscriberSystem)
+
+  /**
+   * @param[in] topic The ROS topic of the full grids; patches are expected
+   * on `<topic>_updates`.
+   *
+   * @param node_handle The ROS context.
+   */
+  RosOccupancyGridSubscriberSystem(const std::string& topic,
+                                   ros::NodeHandle* node_handle)
+      : topic_(topic), node_handle_(node_handle) {
+    DRAKE_DEMAND(node_handle_ != nullptr);
+
+    grid_subscriber_ = node_handle_->subscribe(
+        topic, 1, &RosOccupancyGridSubscriberSystem::HandleGrid, this);
+    update_subscriber_ = node_handle_->subscribe(
+        topic + "_updates", 10, &RosOccupancyGridSubscriberSystem::HandleUpdate,
+        this);
+
+    set_name(make_name(topic_));
+  }
+
+  ~RosOccupancyGridSubscriberSystem() override{};
+
+  const std::string& get_topic_name() const { return topic_; }
+
+  /// Returns the default name for a system that subscribes to @p topic.
+  static std::string make_name(const std::string& topic) {
+    return "RosOccupancyGridSubscriberSystem(" + topic + ")";
+  }
+
+ private:
+  // Takes the grid by pointer to non-const, which roscpp copies only if
+  // another callback shares it, to swap it into the receive buffer.
+  void HandleGrid(const nav_msgs::OccupancyGrid::Ptr& grid) {
+    SPDLOG_TRACE(drake::log(), "Receiving ROS {} message", topic_);
+    HandleMessage(grid.get());
+  }
+
+  void HandleUpdate(const map_msgs::OccupancyGridUpdate::ConstPtr& update) {
+    SPDLOG_TRACE(drake::log(), "Receiving ROS {}_updates message", topic_);
+    ModifyMessage([this, &update](nav_msgs::OccupancyGrid* grid) {
+      const int width = grid->info.width;
+      const int height = grid->info.height;
+      if (grid->data.empty() || update->x < 0 || update->y < 0 ||
+          update->x + static_cast<int>(update->width) > width ||
+          update->y + static_cast<int>(update->height) > height ||
+          update->data.size() !=
+              static_cast<size_t>(update->width) * update->height) {
+        ROS_WARN_THROTTLE(1.0,
+                          "%s: dropping update that does not fit the grid",
+                          topic_.c_str());
+        return false;
+      }
+      for (size_t row = 0; row < update->height; ++row) {
+        std::memcpy(&grid->data[(update->y + row) * width + update->x],
+                    &update->data[row * update->width], update->width);
+      }
+      grid->header.stamp = update->header.stamp;
+      return true;
+    });
+  }
+
+  // The topic on which to receive full grids.
+  const std::string topic_;
+
+  ros::NodeHandle* const node_handle_{};
+
+  ros::Subscriber grid_subscriber_;
+  ros::Subscriber update_subscriber_;
+};
+
+}  // namespace drake_ros_systems
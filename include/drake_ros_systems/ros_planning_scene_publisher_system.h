@@ -0,0 +1,394 @@
+#pragma once
+
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <Eigen/Geometry>
+
+#include "drake/common/drake_copyable.h"
+#include "drake/geometry/query_object.h"
+#include "drake/geometry/scene_graph_inspector.h"
+#include "drake/geometry/shape_specification.h"
+#include "drake/systems/framework/leaf_system.h"
+
+#include "moveit_msgs/CollisionObject.h"
+#include "moveit_msgs/PlanningScene.h"
+#include "ros/ros.h"
+#include "shape_msgs/Mesh.h"
+#include "shape_msgs/SolidPrimitive.h"
+
+namespace drake_ros_systems {
+
+using namespace drake;
+
+/**
+ * Keeps MoveIt's planning scene in sync with the collision geometry of a
+ * geometry::SceneGraph by publishing `moveit_msgs/PlanningScene` diffs
+ * (`is_diff = true`), e.g. on the `planning_scene` topic move_group listens
+ * to.
+ *
+ * Its sole input port takes the SceneGraph's geometry::QueryObject. At every
+ * publish, each geometry with a proximity role is compared to what was sent
+ * before: new geometries are sent with an ADD operation, including their
+ * shape, geometries that moved by more than the tolerances with a MOVE
+ * operation carrying the new pose only, and vanished geometries with a
+ * REMOVE operation. Nothing is published if nothing changed, so meshes cross
+ * the wire once and a moving object costs a pose per update.
+ *
+ * Since the diffs only make sense on top of each other, a subscriber that
+ * connects, e.g. a move_group started late or restarted, is sent every
+ * geometry with an ADD operation at its current pose, over its own
+ * connection only, from the ADD operations kept since they were first sent.
+ * Other subscribers do not see the meshes again. A snapshot with
+ * `is_diff = false` is not used, since it would also reset the robot state
+ * and everything else other nodes put into the scene.
+ *
+ * Objects are named `<frame name>::<geometry name>` and posed in the world
+ * frame, named @p frame_id. Spheres, boxes, cylinders, half spaces and OBJ
+ * meshes (Mesh and Convex) are supported.
+ */
+class RosPlanningSceneDiffPublisherSystem : public systems::LeafSystem<double> {
+ public:
+  DRAKE_NO_COPY_NO_MOVE_NO_ASSIGN(RosPlanningSceneDiffPublisherSystem)
+
+  /**
+   * @param[in] topic The ROS topic on which to publish.
+   *
+   * @param node_handle The ROS context.
+   *
+   * @param[in] publish_period The period of the publish event, in seconds.
+   *
+   * @param[in] frame_id The name of the world frame in MoveIt.
+   */
+  RosPlanningSceneDiffPublisherSystem(const std::string& topic,
+                                      ros::NodeHandle* node_handle,
+                                      double publish_period,
+                                      const std::string& frame_id = "world")
+      : topic_(topic), node_handle_(node_handle), frame_id_(frame_id) {
+    DRAKE_DEMAND(node_handle_ != nullptr);
+
+    publisher_ = node_handle_->advertise<moveit_msgs::PlanningScene>(
+        topic, 10, [this](const ros::SingleSubscriberPublisher& subscriber) {
+          Resync(subscriber);
+        });
+    message_.is_diff = true;
+    message_.robot_state.is_diff = true;
+
+    DeclareAbstractInputPort();
+    DeclarePeriodicPublish(publish_period);
+    set_name(make_name(topic_));
+  }
+
+  ~RosPlanningSceneDiffPublisherSystem() override{};
+
+  const std::string& get_topic_name() const { return topic_; }
+
+  /// Returns the default name for a system that publishes @p topic.
+  static std::string make_name(const std::string& topic) {
+    return "RosPlanningSceneDiffPublisherSystem(" + topic + ")";
+  }
+
+  /**
+   * Sets how far, in meters and radians, a geometry must move before a MOVE
+   * is sent for it.
+   */
+  void set_tolerances(double translation, double rotation) {
+    DRAKE_DEMAND(translation >= 0.0 && rotation >= 0.0);
+    translation_tolerance_ = translation;
+    rotation_tolerance_ = rotation;
+  }
+
+  /// Publishes the changes since the previous publish, if any.
+  void DoPublish(
+      const systems::Context<double>& context,
+      const std::vector<const systems::PublishEvent<double>*>&) const override {
+    const auto& query = EvalAbstractInput(context, 0)
+                            ->GetValue<geometry::QueryObject<double>>();
+    const geometry::SceneGraphInspector<double>& inspector = query.inspector();
+
+    std::vector<moveit_msgs::CollisionObject>& objects =
+        message_.world.collision_objects;
+    objects.clear();
+    std::lock_guard<std::mutex> lock(tracked_mutex_);
+    ++generation_;
+
+    for (const geometry::GeometryId id : inspector.GetAllGeometryIds()) {
+      if (inspector.GetProximityProperties(id) == nullptr) continue;
+      const Eigen::Isometry3d X_WG = query.GetPoseInWorld(id).GetAsIsometry3();
+      auto it = tracked_.find(id);
+      if (it == tracked_.end()) {
+        TrackedObject tracked{
+            inspector.GetName(inspector.GetFrameId(id)) +
+                "::" + inspector.GetName(id),
+            X_WG.linear(), X_WG.translation(), generation_, true, false,
+            false, {}};
+        if (MakeAddObject(inspector.GetShape(id), tracked.name, X_WG,
+                          &tracked.add)) {
+          tracked.is_mesh = !tracked.add.meshes.empty();
+          tracked.is_plane = !tracked.add.planes.empty();
+          objects.push_back(tracked.add);
+        } else {
+          tracked.supported = false;
+          ROS_WARN("%s: unsupported shape of '%s', not sent", topic_.c_str(),
+                   tracked.name.c_str());
+        }
+        // Tracked either way, so that the warning is only given once.
+        tracked_.emplace(id, std::move(tracked));
+        continue;
+      }
+
+      TrackedObject& tracked = it->second;
+      tracked.generation = generation_;
+      if (!tracked.supported) continue;
+      const double translation = (X_WG.translation() - tracked.p_WG).norm();
+      const double rotation =
+          Eigen::AngleAxisd(tracked.R_WG.transpose() * X_WG.linear()).angle();
+      if (translation <= translation_tolerance_ &&
+          rotation <= rotation_tolerance_) {
+        continue;
+      }
+      tracked.R_WG = X_WG.linear();
+      tracked.p_WG = X_WG.translation();
+      objects.emplace_back();
+      moveit_msgs::CollisionObject& object = objects.back();
+      object.header.frame_id = frame_id_;
+      object.id = tracked.name;
+      object.operation = moveit_msgs::CollisionObject::MOVE;
+      // MoveIt expects exactly one pose per shape of the object.
+      std::vector<geometry_msgs::Pose>& poses =
+          tracked.is_mesh ? object.mesh_poses
+                          : tracked.is_plane ? object.plane_poses
+                                             : object.primitive_poses;
+      poses.resize(1);
+      SetPose(X_WG, &poses[0]);
+      SetPoses(poses[0], &tracked.add);
+    }
+
+    for (auto it = tracked_.begin(); it != tracked_.end();) {
+      const TrackedObject& tracked = it->second;
+      if (tracked.generation == generation_) {
+        ++it;
+        continue;
+      }
+      if (tracked.supported) {
+        objects.emplace_back();
+        objects.back().header.frame_id = frame_id_;
+        objects.back().id = tracked.name;
+        objects.back().operation = moveit_msgs::CollisionObject::REMOVE;
+      }
+      it = tracked_.erase(it);
+    }
+
+    if (!objects.empty()) publisher_.publish(message_);
+  }
+
+ private:
+  // Sends every object MoveIt should know to @p subscriber alone. Called from
+  // a ROS callback thread when a subscriber connects.
+  void Resync(const ros::SingleSubscriberPublisher& subscriber) const {
+    moveit_msgs::PlanningScene scene;
+    scene.is_diff = true;
+    scene.robot_state.is_diff = true;
+    {
+      std::lock_guard<std::mutex> lock(tracked_mutex_);
+      for (const auto& entry : tracked_) {
+        if (entry.second.supported) {
+          scene.world.collision_objects.push_back(entry.second.add);
+        }
+      }
+    }
+    if (!scene.world.collision_objects.empty()) subscriber.publish(scene);
+  }
+
+  struct TrackedObject {
+    std::string name;
+    // The pose last sent.
+    Eigen::Matrix3d R_WG;
+    Eigen::Vector3d p_WG;
+    // The publish that last saw the geometry.
+    std::uint64_t generation;
+    // Whether MoveIt knows the object, and which kind of shape it has.
+    bool supported;
+    bool is_mesh;
+    bool is_plane;
+    // The ADD operation of a supported object, at the pose last sent, for
+    // subscribers that connect later.
+    moveit_msgs::CollisionObject add;
+  };
+
+  // Fills @p object with the shape and pose of a new geometry. Returns false
+  // if the shape is not supported.
+  bool MakeAddObject(const geometry::Shape& shape, const std::string& name,
+                     const Eigen::Isometry3d& X_WG,
+                     moveit_msgs::CollisionObject* object) const {
+    object->header.frame_id = frame_id_;
+    object->id = name;
+    object->operation = moveit_msgs::CollisionObject::ADD;
+    geometry_msgs::Pose pose;
+    SetPose(X_WG, &pose);
+
+    ShapeToMessage reifier;
+    shape.Reify(&reifier, object);
+    if (!reifier.supported) return false;
+    SetPoses(pose, object);
+    return true;
+  }
+
+  // Poses every shape of @p object at @p pose.
+  static void SetPoses(const geometry_msgs::Pose& pose,
+                       moveit_msgs::CollisionObject* object) {
+    object->primitive_poses.assign(object->primitives.size(), pose);
+    object->mesh_poses.assign(object->meshes.size(), pose);
+    object->plane_poses.assign(object->planes.size(), pose);
+  }
+
+  // Appends the shape to the moveit_msgs::CollisionObject passed as user
+  // data.
+  class ShapeToMessage : public geometry::ShapeReifier {
+   public:
+    void ImplementGeometry(const geometry::Sphere& sphere,
+                           void* user_data) override {
+      AddPrimitive(shape_msgs::SolidPrimitive::SPHERE, {sphere.get_radius()},
+                   user_data);
+    }
+
+    void ImplementGeometry(const geometry::Box& box, void* user_data) override {
+      AddPrimitive(shape_msgs::SolidPrimitive::BOX,
+                   {box.width(), box.depth(), box.height()}, user_data);
+    }
+
+    void ImplementGeometry(const geometry::Cylinder& cylinder,
+                           void* user_data) override {
+      AddPrimitive(shape_msgs::SolidPrimitive::CYLINDER,
+                   {cylinder.get_length(), cylinder.get_radius()}, user_data);
+    }
+
+    void ImplementGeometry(const geometry::HalfSpace&,
+                           void* user_data) override {
+      // The half space's boundary is the z = 0 plane of its frame, with the
+      // solid below.
+      shape_msgs::Plane plane;
+      plane.coef = {{0.0, 0.0, 1.0, 0.0}};
+      static_cast<moveit_msgs::CollisionObject*>(user_data)->planes.push_back(
+          plane);
+      supported = true;
+    }
+
+    void ImplementGeometry(const geometry::Mesh& mesh,
+                           void* user_data) override {
+      AddObjMesh(mesh.filename(), mesh.scale(), user_data);
+    }
+
+    void ImplementGeometry(const geometry::Convex& convex,
+                           void* user_data) override {
+      AddObjMesh(convex.filename(), convex.scale(), user_data);
+    }
+
+    bool supported{false};
+
+   private:
+    void AddPrimitive(std::uint8_t type, const std::vector<double>& dimensions,
+                      void* user_data) {
+      shape_msgs::SolidPrimitive primitive;
+      primitive.type = type;
+      primitive.dimensions = dimensions;
+      static_cast<moveit_msgs::CollisionObject*>(user_data)
+          ->primitives.push_back(primitive);
+      supported = true;
+    }
+
+    // Reads the vertices and faces of an OBJ file; polygons are fanned into
+    // triangles. Skips the whole mesh, with a warning, if a face refers to a
+    // vertex that does not exist.
+    void AddObjMesh(const std::string& filename, double scale,
+                    void* user_data) {
+      std::ifstream file(filename);
+      if (!file) return;
+      shape_msgs::Mesh mesh;
+      std::string line;
+      while (std::getline(file, line)) {
+        std::istringstream tokens(line);
+        std::string keyword;
+        tokens >> keyword;
+        if (keyword == "v") {
+          geometry_msgs::Point vertex;
+          tokens >> vertex.x >> vertex.y >> vertex.z;
+          vertex.x *= scale;
+          vertex.y *= scale;
+          vertex.z *= scale;
+          mesh.vertices.push_back(vertex);
+        } else if (keyword == "f") {
+          std::vector<std::uint32_t> polygon;
+          std::string corner;
+          while (tokens >> corner) {
+            // "v", "v/vt", "v//vn" or "v/vt/vn", 1-based, or negative to
+            // count back from the last vertex read so far.
+            const char* begin = corner.c_str();
+            char* end{};
+            const long index = std::strtol(begin, &end, 10);
+            const long num_vertices = static_cast<long>(mesh.vertices.size());
+            const long resolved = index < 0 ? num_vertices + index : index - 1;
+            if (end == begin || (*end != '\0' && *end != '/') || index == 0 ||
+                resolved < 0 || resolved >= num_vertices) {
+              ROS_WARN("Invalid face '%s' in '%s', mesh skipped", line.c_str(),
+                       filename.c_str());
+              return;
+            }
+            polygon.push_back(static_cast<std::uint32_t>(resolved));
+          }
+          for (std::size_t i = 2; i < polygon.size(); ++i) {
+            shape_msgs::MeshTriangle triangle;
+            triangle.vertex_indices = {{polygon[0], polygon[i - 1],
+                                        polygon[i]}};
+            mesh.triangles.push_back(triangle);
+          }
+        }
+      }
+      if (mesh.triangles.empty()) return;
+      static_cast<moveit_msgs::CollisionObject*>(user_data)->meshes.push_back(
+          mesh);
+      supported = true;
+    }
+  };
+
+  static void SetPose(const Eigen::Isometry3d& X, geometry_msgs::Pose* pose) {
+    const Eigen::Quaterniond q(X.linear());
+    pose->position.x = X.translation().x();
+    pose->position.y = X.translation().y();
+    pose->position.z = X.translation().z();
+    pose->orientation.w = q.w();
+    pose->orientation.x = q.x();
+    pose->orientation.y = q.y();
+    pose->orientation.z = q.z();
+  }
+
+  // The topic on which to publish planning scene diffs.
+  const std::string topic_;
+
+  ros::NodeHandle* const node_handle_{};
+  ros::Publisher publisher_;
+  const std::string frame_id_;
+
+  double translation_tolerance_{1e-4};
+  double rotation_tolerance_{1e-3};
+
+  // What MoveIt has been told, by geometry.
+  mutable std::unordered_map<geometry::GeometryId, TrackedObject> tracked_;
+  mutable std::uint64_t generation_{0};
+
+  // Guards tracked_ against the publisher's connect callback, which runs on
+  // a ROS callback thread.
+  mutable std::mutex tracked_mutex_;
+
+  // Reused between publishes.
+  mutable moveit_msgs::PlanningScene message_;
+};
+
+}  // namespace drake_ros_systems
@@ -2,13 +2,20 @@
 
 #include <memory>
 #include <string>
+#include <typeinfo>
 #include <vector>
 
 #include "drake/common/drake_copyable.h"
 #include "drake/lcm/drake_lcm_interface.h"
 #include "drake/systems/framework/leaf_system.h"
+#include "drake/systems/framework/witness_function.h"
 
+#include "boost/make_shared.hpp"
+#include "ros/publication.h"
 #include "ros/ros.h"
+#include "ros/topic_manager.h"
+
+#include "drake_ros_systems/network_impairment.h"
 
 namespace drake_ros_systems {
 
@@ -39,6 +46,27 @@ class RosPublisherSystem : public systems::LeafSystem<double> {
     return std::make_unique<RosPublisherSystem<RosMessage>>(topic, node_handle);
   }
 
+  /**
+   * A factory method that returns a latched %RosPublisherSystem, meant for
+   * data that rarely or never changes (robot descriptions, camera info,
+   * static maps). It publishes once when the simulation is initialized; the
+   * ROS publisher is latched, so late subscribers still get that message
+   * immediately. Without a publish period it never publishes again, and
+   * costs nothing after initialization. For data that does change, call
+   * set_publish_period(): at every period, the input is serialized and only
+   * published if the bytes differ from the last published ones, which costs
+   * a serialization per period but no bandwidth.
+   *
+   * @param[in] topic The ROS topic on which to publish.
+   *
+   * @param node_handle The ROS context.
+   */
+  static std::unique_ptr<RosPublisherSystem<RosMessage>> MakeLatched(
+      const std::string& topic, ros::NodeHandle* node_handle) {
+    return std::make_unique<RosPublisherSystem<RosMessage>>(topic, node_handle,
+                                                            true);
+  }
+
   // TODO(gizatt): add multiple DrakeRosInterface, so you can publish to a log
   // and real lcm at the same time. (TODO cloned from LCM publisher system,
   // originally attributed to Siyuan.)
@@ -51,12 +79,20 @@ class RosPublisherSystem : public systems::LeafSystem<double> {
    * @param[in] topic The ROS topic on which to publish.
    *
    * @param node_handle The ROS context.
+   *
+   * @param[in] latched Whether to publish in latched mode, see MakeLatched().
    */
-  RosPublisherSystem(const std::string& topic, ros::NodeHandle* node_handle)
-      : topic_(topic), node_handle_(node_handle) {
+  RosPublisherSystem(const std::string& topic, ros::NodeHandle* node_handle,
+                     bool latched = false)
+      : topic_(topic), node_handle_(node_handle), latched_(latched) {
     DRAKE_DEMAND(node_handle_ != nullptr);
 
-    publisher_ = node_handle->advertise<RosMessage>(topic, 0);
+    publisher_ = node_handle->advertise<RosMessage>(topic, latched_ ? 1 : 0,
+                                                    latched_);
+    if (latched_) {
+      this->DeclareInitializationEvent(systems::PublishEvent<double>(
+          systems::Event<double>::TriggerType::kInitialization));
+    }
 
     DeclareAbstractInputPort();
     set_name(make_name(topic_));
@@ -66,6 +102,14 @@ class RosPublisherSystem : public systems::LeafSystem<double> {
 
   const std::string& get_topic_name() const { return topic_; }
 
+  bool is_latched() const { return latched_; }
+
+  /// Returns the number of subscribers currently connected to the topic.
+  int get_num_subscribers() const { return publisher_.getNumSubscribers(); }
+
+  /// Returns the number of messages published so far.
+  int get_published_message_count() const { return published_message_count_; }
+
   /// Returns the default name for a system that publishes @p topic.
   static std::string make_name(const std::string& topic) {
     return "RosPublisherSystem(" + topic + ")";
@@ -80,6 +124,53 @@ class RosPublisherSystem : public systems::LeafSystem<double> {
     LeafSystem<double>::DeclarePeriodicPublish(period);
   }
 
+  /**
+   * Adds a second, vector-valued input port of size 1 whose crossings of
+   * zero, in the given @p direction, trigger a publish. The crossing is
+   * watched by a witness function, so the Simulator localizes it and the
+   * message goes out at the event time rather than at the next period or
+   * step. Can be combined with, or used instead of, set_publish_period().
+   * Returns the new port.
+   */
+  const systems::InputPort<double>& DeclarePublishTrigger(
+      systems::WitnessFunctionDirection direction =
+          systems::WitnessFunctionDirection::kCrossesZero) {
+    DRAKE_DEMAND(trigger_witness_ == nullptr);
+    const systems::InputPort<double>& trigger_port =
+        this->DeclareInputPort(systems::kVectorValued, 1);
+    trigger_witness_ = this->DeclareWitnessFunction(
+        make_name(topic_) + " publish trigger", direction,
+        &RosPublisherSystem::CalcTriggerValue,
+        systems::PublishEvent<double>(
+            systems::Event<double>::TriggerType::kWitness));
+    return trigger_port;
+  }
+
+  /**
+   * Routes every outgoing message through an emulated impaired link before it
+   * reaches the ROS transport. See NetworkImpairmentConfig for the available
+   * impairments. Must be called before simulation starts.
+   */
+  void set_network_impairment(const NetworkImpairmentConfig& config) {
+    impairment_ = std::make_unique<NetworkImpairment<RosMessage>>(
+        config, [this](const RosMessage& message) {
+          this->PublishToTransport(message);
+        });
+  }
+
+  /// Returns the active link emulation, or nullptr if there is none.
+  const NetworkImpairment<RosMessage>* get_network_impairment() const {
+    return impairment_.get();
+  }
+
+  /// Reports the publish trigger's witness function, if there is one.
+  void DoGetWitnessFunctions(
+      const systems::Context<double>&,
+      std::vector<const systems::WitnessFunction<double>*>* witnesses)
+      const override {
+    if (trigger_witness_) witnesses->push_back(trigger_witness_.get());
+  }
+
   /**
    * Takes the VectorBase from the input port of the context and publishes
    * it onto an ROS topic.
@@ -93,17 +184,87 @@ class RosPublisherSystem : public systems::LeafSystem<double> {
         this->EvalAbstractInput(context, kPortIndex);
     DRAKE_ASSERT(input_value != nullptr);
 
-    publisher_.publish(input_value->GetValue<RosMessage>());
+    const RosMessage& message = input_value->GetValue<RosMessage>();
+    if (latched_ && !HasChangedSinceLastPublish(message)) return;
+    ++published_message_count_;
+    if (impairment_) {
+      impairment_->Send(message);
+    } else {
+      PublishToTransport(message);
+    }
   }
 
  private:
+  // Hands @p message to ROS. Intra-process subscribers (e.g. in the same
+  // nodelet manager) receive messages by pointer, without any serialization,
+  // so only when there are some is a copy made to be shared with them;
+  // otherwise the message is serialized straight from the input port.
+  void PublishToTransport(const RosMessage& message) const {
+    if (HasIntraProcessSubscribers()) {
+      publisher_.publish(boost::make_shared<RosMessage>(message));
+    } else {
+      publisher_.publish(message);
+    }
+  }
+
+  // Asks roscpp whether a subscriber in this process takes RosMessage by
+  // pointer, as it would when handed a shared pointer.
+  bool HasIntraProcessSubscribers() const {
+    const ros::PublicationPtr publication =
+        ros::TopicManager::instance()->lookupPublication(publisher_.getTopic());
+    bool serialize = false;
+    bool nocopy = false;
+    if (publication)
+      publication->getPublishTypes(serialize, nocopy, typeid(RosMessage));
+    return nocopy;
+  }
+
+  // The value watched by trigger_witness_.
+  double CalcTriggerValue(const systems::Context<double>& context) const {
+    return this->EvalVectorInput(context, kTriggerPortIndex)->GetAtIndex(0);
+  }
+
+  // Serializes @p message and compares it with the last published bytes.
+  // Returns true, and remembers the new bytes, if they differ.
+  bool HasChangedSinceLastPublish(const RosMessage& message) const {
+    namespace ser = ros::serialization;
+    const uint32_t length = ser::serializationLength(message);
+    serialized_.resize(length);
+    ser::OStream stream(serialized_.data(), length);
+    ser::serialize(stream, message);
+    if (has_published_ && serialized_ == last_published_) return false;
+    serialized_.swap(last_published_);
+    has_published_ = true;
+    return true;
+  }
+
   // The topic on which to publish ROS messages.
   const std::string topic_;
 
   ros::NodeHandle* const node_handle_{};
   ros::Publisher publisher_;
 
+  const bool latched_{false};
+
+  // In latched mode, the serialized form of the last published message, and
+  // a scratch buffer for the current one.
+  mutable bool has_published_{false};
+  mutable std::vector<uint8_t> last_published_;
+  mutable std::vector<uint8_t> serialized_;
+
+  // Simulation thread only.
+  mutable int published_message_count_{0};
+
   const int kPortIndex = 0;
+  const int kTriggerPortIndex = 1;
+
+  // Triggers a publish at every zero crossing of the trigger input, if
+  // DeclarePublishTrigger() was called.
+  std::unique_ptr<systems::WitnessFunction<double>> trigger_witness_;
+
+  // Optional link emulation between DoPublish() and publisher_. Declared
+  // after publisher_ so that its delivery thread is joined first.
+  std::unique_ptr<NetworkImpairment<RosMessage>> impairment_;
 };
 
 }  // namespace drake_ros_systems
@@ -0,0 +1,186 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <Eigen/Core>
+
+#include "drake/common/drake_copyable.h"
+#include "drake/systems/framework/leaf_system.h"
+
+#include "ros/ros.h"
+
+#include "drake_ros_systems/SignalScope.h"
+#include "drake_ros_systems/SignalScopeChannels.h"
+
+namespace drake_ros_systems {
+
+using namespace drake;
+
+/**
+ * Streams many scalar signals for live plotting (e.g. with PlotJuggler) at a
+ * fraction of the bandwidth of publishing every sample.
+ *
+ * Every vector-valued input port added with AddInput() contributes one
+ * channel per element. The inputs are sampled on every simulation step, and
+ * the minimum, maximum, mean and last value of each channel are accumulated
+ * over windows of `window` seconds of simulation time; unlike plain
+ * decimation, spikes between two publishes still show up in the min/max
+ * traces. At the first step past the end of a window, one SignalScope
+ * message with all channels is published and accumulation restarts. The
+ * mean weighs every step equally, so it is not a time-weighted average when
+ * steps vary in length, and the last, partial window of a simulation is
+ * never published.
+ *
+ * The channel names are not repeated in every window: they are published
+ * once, as a SignalScopeChannels message latched on `<topic>/channels`, and
+ * each SignalScope message carries the layout_id of the channels it is
+ * indexed by.
+ *
+ * The accumulators and the message are allocated once, when the first
+ * sample is taken. The accumulators live outside of the Context, so a
+ * system instance must only be simulated in one Context at a time.
+ */
+class RosSignalScopePublisherSystem : public systems::LeafSystem<double> {
+ public:
+  DRAKE_NO_COPY_NO_MOVE_NO_ASSIGN(RosSignalScopePublisherSystem)
+
+  /**
+   * @param[in] topic The ROS topic on which to publish.
+   *
+   * @param node_handle The ROS context.
+   *
+   * @param[in] window Length of a window in seconds of simulation time.
+   */
+  RosSignalScopePublisherSystem(const std::string& topic,
+                                ros::NodeHandle* node_handle, double window)
+      : topic_(topic), node_handle_(node_handle), window_(window) {
+    DRAKE_DEMAND(node_handle_ != nullptr);
+    DRAKE_DEMAND(window_ > 0.0);
+
+    publisher_ = node_handle_->advertise<SignalScope>(topic, 10);
+    channels_publisher_ = node_handle_->advertise<SignalScopeChannels>(
+        topic + "/channels", 1, true /* latch */);
+
+    this->DeclarePerStepEvent(systems::PublishEvent<double>(
+        systems::Event<double>::TriggerType::kPerStep));
+    set_name(make_name(topic_));
+  }
+
+  ~RosSignalScopePublisherSystem() override{};
+
+  const std::string& get_topic_name() const { return topic_; }
+
+  /// Returns the default name for a system that publishes @p topic.
+  static std::string make_name(const std::string& topic) {
+    return "RosSignalScopePublisherSystem(" + topic + ")";
+  }
+
+  /**
+   * Adds a vector-valued input port of @p size elements, whose channels are
+   * called `name` if @p size is 1 and `name[i]` otherwise. Returns the new
+   * port.
+   */
+  const systems::InputPort<double>& AddInput(const std::string& name,
+                                             int size) {
+    DRAKE_DEMAND(size >= 1);
+    for (int i = 0; i < size; ++i) {
+      channels_.channel_names.push_back(
+          size == 1 ? name : name + "[" + std::to_string(i) + "]");
+    }
+    ++channels_.layout_id;
+    return this->DeclareInputPort(systems::kVectorValued, size);
+  }
+
+  /// Samples all inputs, and publishes the window if it is complete.
+  void DoPublish(
+      const systems::Context<double>& context,
+      const std::vector<const systems::PublishEvent<double>*>&) const override {
+    const double time = context.get_time();
+    if (message_.layout_id != channels_.layout_id) {
+      const int num_channels =
+          static_cast<int>(channels_.channel_names.size());
+      sample_.resize(num_channels);
+      min_.resize(num_channels);
+      max_.resize(num_channels);
+      sum_.resize(num_channels);
+      message_.min.resize(num_channels);
+      message_.max.resize(num_channels);
+      message_.mean.resize(num_channels);
+      message_.last.resize(num_channels);
+      message_.layout_id = channels_.layout_id;
+      channels_publisher_.publish(channels_);
+      num_samples_ = 0;
+    }
+
+    if (num_samples_ > 0 && time >= window_start_ + window_) {
+      PublishWindow(time);
+      num_samples_ = 0;
+    }
+
+    int channel = 0;
+    for (int i = 0; i < this->get_num_input_ports(); ++i) {
+      const auto value = this->EvalVectorInput(context, i)->get_value();
+      sample_.segment(channel, value.size()) = value.array();
+      channel += value.size();
+    }
+
+    if (num_samples_ == 0) {
+      window_start_ = time;
+      min_ = sample_;
+      max_ = sample_;
+      sum_ = sample_;
+    } else {
+      min_ = min_.min(sample_);
+      max_ = max_.max(sample_);
+      sum_ += sample_;
+    }
+    ++num_samples_;
+  }
+
+ private:
+  void PublishWindow(double window_end) const {
+    SPDLOG_TRACE(drake::log(), "Publishing ROS {} message", topic_);
+    const int num_channels = static_cast<int>(sample_.size());
+    message_.header.stamp = ros::Time(window_end);
+    message_.window_start = window_start_;
+    message_.window_end = window_end;
+    message_.num_samples = num_samples_;
+    Eigen::Map<Eigen::ArrayXf>(message_.min.data(), num_channels) =
+        min_.cast<float>();
+    Eigen::Map<Eigen::ArrayXf>(message_.max.data(), num_channels) =
+        max_.cast<float>();
+    Eigen::Map<Eigen::ArrayXf>(message_.mean.data(), num_channels) =
+        (sum_ / num_samples_).cast<float>();
+    // The last sample of the window is still in sample_.
+    Eigen::Map<Eigen::ArrayXf>(message_.last.data(), num_channels) =
+        sample_.cast<float>();
+    publisher_.publish(message_);
+  }
+
+  // The topic on which to publish windows.
+  const std::string topic_;
+
+  ros::NodeHandle* const node_handle_{};
+  ros::Publisher publisher_;
+  ros::Publisher channels_publisher_;
+
+  const double window_;
+
+  // Accumulators of the current window, and the latest sample.
+  mutable double window_start_{0.0};
+  mutable int num_samples_{0};
+  mutable Eigen::ArrayXd sample_;
+  mutable Eigen::ArrayXd min_;
+  mutable Eigen::ArrayXd max_;
+  mutable Eigen::ArrayXd sum_;
+
+  // The channel names, and how many times channels were added.
+  SignalScopeChannels channels_;
+
+  // The message reused by every publish.
+  mutable SignalScope message_;
+};
+
+}  // namespace drake_ros_systems
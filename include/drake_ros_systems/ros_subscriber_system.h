@@ -1,15 +1,17 @@
 #pragma once
 
-#include <condition_variable>
 #include <memory>
 #include <string>
-#include <vector>
+#include <utility>
 
 #include "drake/common/drake_copyable.h"
-#include "drake/systems/framework/leaf_system.h"
 
 #include "ros/ros.h"
 
+#include "drake_ros_systems/network_impairment.h"
+#include "drake_ros_systems/stale_message_filter.h"
+#include "drake_ros_systems/subscriber_system_base.h"
+
 namespace drake_ros_systems {
 
 using namespace drake;
@@ -33,7 +35,7 @@ using namespace drake;
  * (Direct clone of LcmSubscriberSystem with pared-down features.)
  */
 template <typename RosMessage>
-class RosSubscriberSystem : public systems::LeafSystem<double> {
+class RosSubscriberSystem : public SubscriberSystemBase<RosMessage> {
  public:
   DRAKE_NO_COPY_NO_MOVE_NO_ASSIGN(RosSubscriberSystem)
 
@@ -67,21 +69,16 @@ class RosSubscriberSystem : public systems::LeafSystem<double> {
     DRAKE_DEMAND(node_handle_);
 
     subscriber_ = node_handle->subscribe(
-        topic, 100, &RosSubscriberSystem<RosMessage>::HandleMessage, this);
-
-    DeclareAbstractOutputPort(
-        [this](const systems::Context<double>&) {
-          return this->AllocateOutputValue();
-        },
-        [this](const systems::Context<double>& context,
-               systems::AbstractValue* out) {
-          this->CalcOutputValue(context, out);
-        });
-
-    set_name(make_name(topic_));
+        topic, 100, &RosSubscriberSystem<RosMessage>::HandleTransportMessage,
+        this);
+
+    this->set_name(make_name(topic_));
   }
 
-  ~RosSubscriberSystem() override{};
+  ~RosSubscriberSystem() override {
+    // Stop new callbacks before impairment_ goes away.
+    subscriber_.shutdown();
+  };
 
   const std::string& get_topic_name() const { return topic_; }
 
@@ -91,132 +88,77 @@ class RosSubscriberSystem : public systems::LeafSystem<double> {
   }
 
   /**
-   * Blocks the caller until @p old_message_count is different from the
-   * internal message counter, and the internal message counter is returned.
+   * Routes every incoming message through an emulated impaired link before it
+   * reaches HandleMessage(). See NetworkImpairmentConfig for the available
+   * impairments. Must be called before the ROS callbacks are being spun.
    */
-  int WaitForMessage(int old_message_count) const {
-    // The message buffer and counter are updated in HandleMessage(), which is
-    // a callback function invoked by a potentially different thread. Thus,
-    // for thread safety, these need to be properly protected by a mutex.
-    std::unique_lock<std::mutex> lock(received_message_mutex_);
-
-    // This while loop is necessary to guard for spurious wakeup:
-    // https://en.wikipedia.org/wiki/Spurious_wakeup
-    while (old_message_count == received_message_count_)
-      // When wait returns, lock is atomically acquired. So it's thread safe to
-      // read received_message_count_.
-      received_message_condition_variable_.wait(lock);
-    int new_message_count = received_message_count_;
-    lock.unlock();
-
-    return new_message_count;
+  void set_network_impairment(const NetworkImpairmentConfig& config) {
+    impairment_ = std::make_unique<NetworkImpairment<RosMessage>>(
+        config,
+        [this](const RosMessage& message) { this->HandleMessage(message); });
   }
 
-  /**
-   * Returns the message counter stored in @p context.
-   */
-  int GetMessageCount(const systems::Context<double>& context) const {
-    // Gets the last message count from abstract state.
-    return context.get_abstract_state<int>(kStateIndexMessageCount);
+  /// Returns the active link emulation, or nullptr if there is none.
+  const NetworkImpairment<RosMessage>* get_network_impairment() const {
+    return impairment_.get();
   }
 
- protected:
-  void DoCalcNextUpdateTime(const systems::Context<double>& context,
-                            systems::CompositeEventCollection<double>* events,
-                            double* time) const override {
-    const int last_message_count = GetMessageCount(context);
-
-    const int received_message_count = [this]() {
-      std::unique_lock<std::mutex> lock(received_message_mutex_);
-      return received_message_count_;
-    }();
-
-    // Has a new message. Schedule an update event.
-    if (last_message_count != received_message_count) {
-      // TODO(siyuan): should be context.get_time() once #5725 is resolved.
-      *time = context.get_time() + 0.0001;
-
-      systems::EventCollection<systems::UnrestrictedUpdateEvent<double>>&
-          uu_events = events->get_mutable_unrestricted_update_events();
-      uu_events.add_event(
-          std::make_unique<systems::UnrestrictedUpdateEvent<double>>(
-              systems::Event<double>::TriggerType::kTimed));
-    }
-  }
-
-  void DoCalcUnrestrictedUpdate(
-      const systems::Context<double>&,
-      const std::vector<const systems::UnrestrictedUpdateEvent<double>*>&,
-      systems::State<double>* state) const override {
-    ProcessMessageAndStoreToAbstractState(&state->get_mutable_abstract_state());
+  /**
+   * Drops every message stamped more than @p horizon seconds before the
+   * newest message accepted so far, e.g. the backlog delivered after a pause
+   * or a reconnection. Serialized messages are checked on their header bytes
+   * alone, before they are deserialized. RosMessage must have a header. Must
+   * be called before the ROS callbacks are being spun.
+   */
+  void set_stale_message_horizon(double horizon) {
+    subscriber_.shutdown();
+    stale_message_filter_ = std::make_unique<StaleMessageFilter>(horizon);
+    subscriber_ = node_handle_->subscribe(
+        MakeStaleMessageFilterSubscribeOptions<RosMessage>(
+            topic_, 100, stale_message_filter_.get(),
+            [this](const boost::shared_ptr<RosMessage>& message) {
+              this->HandleTransportMessage(message);
+            }));
   }
 
-  std::unique_ptr<systems::AbstractValues> AllocateAbstractState()
-      const override {
-    std::vector<std::unique_ptr<systems::AbstractValue>> abstract_vals(2);
-    abstract_vals[kStateIndexMessage] =
-        this->RosSubscriberSystem::AllocateOutputValue();
-    abstract_vals[kStateIndexMessageCount] =
-        systems::AbstractValue::Make<int>(0);
-    return std::make_unique<systems::AbstractValues>(std::move(abstract_vals));
+  /// Returns the number of messages dropped as stale so far.
+  int get_stale_message_count() const {
+    return stale_message_filter_ ? stale_message_filter_->get_stale_count()
+                                 : 0;
   }
 
-  void SetDefaultState(const systems::Context<double>& context,
-                       systems::State<double>* state) const override {
-    ProcessMessageAndStoreToAbstractState(&state->get_mutable_abstract_state());
-  };
-
  private:
-  void ProcessMessageAndStoreToAbstractState(
-      systems::AbstractValues* abstract_state) const {
-    std::lock_guard<std::mutex> lock(received_message_mutex_);
-    abstract_state->get_mutable_value(kStateIndexMessage)
-        .GetMutableValue<RosMessage>() = received_message_;
-    abstract_state->get_mutable_value(kStateIndexMessageCount)
-        .GetMutableValue<int>() = received_message_count_;
-  };
-
-  // Callback entry point from ROS into this class. Also wakes up one thread
-  // block on notification_ if it's not nullptr.
-  void HandleMessage(const RosMessage& message) {
+  // Callback entry point from ROS into this class. Passes the message on to
+  // HandleMessage(), through the emulated link if there is one. Taking the
+  // message by pointer lets intra-process publishers (e.g. nodelets) hand it
+  // over without serialization. The pointer is to non-const, so roscpp copies
+  // the message only if another callback shares it, and the message can be
+  // moved into the emulated link, through NetworkImpairment::Send(T&&),
+  // rather than copied again.
+  void HandleTransportMessage(const boost::shared_ptr<RosMessage>& message) {
     SPDLOG_TRACE(drake::log(), "Receiving ROS {} message", topic_);
-    std::lock_guard<std::mutex> lock(received_message_mutex_);
-    received_message_ = message;
-    received_message_count_++;
-    received_message_condition_variable_.notify_all();
-  }
-
-  // This pair of methods is used for the output port when we're using a
-  // serializer.
-  std::unique_ptr<systems::AbstractValue> AllocateOutputValue() const {
-    return std::make_unique<systems::Value<RosMessage>>(RosMessage{});
-  }
-  void CalcOutputValue(const systems::Context<double>& context,
-                       systems::AbstractValue* output_value) const {
-    output_value->SetFrom(
-        context.get_abstract_state().get_value(kStateIndexMessage));
+    if (impairment_) {
+      impairment_->Send(std::move(*message));
+    } else {
+      this->HandleMessage(message.get());
+    }
   }
 
   // The topic on which to receive ROS messages.
   const std::string topic_;
 
-  // The mutex that guards received_message_ and received_message_count_.
-  mutable std::mutex received_message_mutex_;
-
-  // A condition variable that's signaled every time the handler is called.
-  mutable std::condition_variable received_message_condition_variable_;
-
-  // The most recently received ROS message.
-  RosMessage received_message_{};
+  ros::NodeHandle* const node_handle_{};
 
-  // A message counter that's incremented every time the handler is called.
-  int received_message_count_{0};
+  // Optional filter in front of HandleTransportMessage(); see
+  // set_stale_message_horizon().
+  std::unique_ptr<StaleMessageFilter> stale_message_filter_;
 
-  ros::NodeHandle* const node_handle_{};
   ros::Subscriber subscriber_;
 
-  constexpr static int kStateIndexMessage = 0;
-  constexpr static int kStateIndexMessageCount = 1;
+  // Optional link emulation between subscriber_ and HandleMessage(). Declared
+  // last so that its delivery thread is joined before anything it touches is
+  // destroyed.
+  std::unique_ptr<NetworkImpairment<RosMessage>> impairment_;
 };
 
 }  // namespace drake_ros_systems
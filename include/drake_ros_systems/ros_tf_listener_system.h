@@ -0,0 +1,150 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <Eigen/Geometry>
+
+#include "drake/common/drake_copyable.h"
+#include "drake/systems/framework/leaf_system.h"
+
+#include "ros/ros.h"
+#include "tf2_ros/buffer.h"
+#include "tf2_ros/transform_listener.h"
+
+namespace drake_ros_systems {
+
+using namespace drake;
+
+/**
+ * Listens to the ROS tf tree and outputs the transforms between configured
+ * pairs of frames.
+ *
+ * A tf2 buffer is filled by a transform listener on its own callback thread.
+ * Every frame pair added with AddFramePair() gets an abstract-valued output
+ * port carrying an Eigen::Isometry3d `X_TS`, the pose of the source frame in
+ * the target frame, looked up at the context time (interpreted as ROS time,
+ * so run with /use_sim_time and a clock matching the simulation). tf2
+ * interpolates between the stamped transforms around that time.
+ *
+ * Composing a chain of transforms is the costly part of a lookup, so the
+ * result of each pair is cached and reused until either the context time
+ * changes or new tf data arrives. If a lookup fails, e.g. because the data
+ * does not reach the requested time yet, the last successful transform (or
+ * identity) is output and a throttled warning is logged.
+ */
+class RosTfListenerSystem : public systems::LeafSystem<double> {
+ public:
+  DRAKE_NO_COPY_NO_MOVE_NO_ASSIGN(RosTfListenerSystem)
+
+  /**
+   * @param node_handle The ROS context the listener subscribes through.
+   *
+   * @param[in] cache_time How far back in time the buffer keeps transforms.
+   */
+  explicit RosTfListenerSystem(ros::NodeHandle* node_handle,
+                               double cache_time = 10.0)
+      : node_handle_(node_handle), buffer_(ros::Duration(cache_time)) {
+    DRAKE_DEMAND(node_handle_ != nullptr);
+    transforms_changed_connection_ = buffer_._addTransformsChangedListener(
+        [this]() { ++this->tf_generation_; });
+    // Spins its own thread, so no spinner is needed for tf to arrive.
+    listener_ = std::make_unique<tf2_ros::TransformListener>(
+        buffer_, *node_handle_, true);
+    set_name("RosTfListenerSystem");
+  }
+
+  ~RosTfListenerSystem() override {
+    listener_.reset();
+    buffer_._removeTransformsChangedListener(transforms_changed_connection_);
+  }
+
+  /**
+   * Adds an output port carrying Value<Eigen::Isometry3d>, the pose of
+   * @p source_frame in @p target_frame. Returns the new port.
+   */
+  const systems::OutputPort<double>& AddFramePair(
+      const std::string& target_frame, const std::string& source_frame) {
+    const int pair_index = static_cast<int>(frame_pairs_.size());
+    frame_pairs_.push_back(
+        std::make_unique<FramePair>(target_frame, source_frame));
+    return DeclareAbstractOutputPort(
+        [](const systems::Context<double>&) {
+          return systems::AbstractValue::Make<Eigen::Isometry3d>(
+              Eigen::Isometry3d::Identity());
+        },
+        [this, pair_index](const systems::Context<double>& context,
+                           systems::AbstractValue* out) {
+          this->CalcTransform(pair_index, context,
+                              &out->GetMutableValue<Eigen::Isometry3d>());
+        });
+  }
+
+  /// Returns the tf2 buffer, e.g. to make ad-hoc lookups.
+  const tf2_ros::Buffer& get_buffer() const { return buffer_; }
+
+ private:
+  struct FramePair {
+    FramePair(const std::string& target, const std::string& source)
+        : target_frame(target), source_frame(source) {}
+
+    const std::string target_frame;
+    const std::string source_frame;
+
+    // The mutex that guards the cache below.
+    std::mutex mutex;
+    bool cache_valid{false};
+    std::uint64_t cache_generation{0};
+    double cache_time{0.0};
+    Eigen::Isometry3d X_TS{Eigen::Isometry3d::Identity()};
+  };
+
+  void CalcTransform(int pair_index, const systems::Context<double>& context,
+                     Eigen::Isometry3d* X_TS) const {
+    FramePair& pair = *frame_pairs_[pair_index];
+    const double time = context.get_time();
+    const std::uint64_t generation = tf_generation_;
+
+    std::lock_guard<std::mutex> lock(pair.mutex);
+    if (!pair.cache_valid || pair.cache_generation != generation ||
+        pair.cache_time != time) {
+      try {
+        const geometry_msgs::TransformStamped transform =
+            buffer_.lookupTransform(pair.target_frame, pair.source_frame,
+                                    ros::Time(time));
+        const auto& t = transform.transform.translation;
+        const auto& q = transform.transform.rotation;
+        pair.X_TS.setIdentity();
+        pair.X_TS.translate(Eigen::Vector3d(t.x, t.y, t.z));
+        pair.X_TS.rotate(Eigen::Quaterniond(q.w, q.x, q.y, q.z));
+        pair.cache_valid = true;
+        pair.cache_generation = generation;
+        pair.cache_time = time;
+      } catch (const tf2::TransformException& e) {
+        // Not cached, so that the lookup is retried on the next evaluation.
+        ROS_WARN_THROTTLE(1.0, "RosTfListenerSystem: %s -> %s: %s",
+                          pair.target_frame.c_str(),
+                          pair.source_frame.c_str(), e.what());
+      }
+    }
+    *X_TS = pair.X_TS;
+  }
+
+  ros::NodeHandle* const node_handle_{};
+
+  tf2_ros::Buffer buffer_;
+  std::unique_ptr<tf2_ros::TransformListener> listener_;
+  boost::signals2::connection transforms_changed_connection_;
+
+  // Incremented every time new data enters buffer_, which invalidates all
+  // cached lookups.
+  std::atomic<std::uint64_t> tf_generation_{0};
+
+  std::vector<std::unique_ptr<FramePair>> frame_pairs_;
+};
+
+}  // namespace drake_ros_systems
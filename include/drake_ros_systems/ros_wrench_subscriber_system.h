@@ -0,0 +1,239 @@
+#pragma once
+
+#include <atomic>
+#include <map>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <Eigen/Core>
+
+#include "boost/bind.hpp"
+
+#include "drake/common/drake_copyable.h"
+#include "drake/math/rigid_transform.h"
+#include "drake/multibody/plant/externally_applied_spatial_force.h"
+#include "drake/multibody/plant/multibody_plant.h"
+
+#include "geometry_msgs/WrenchStamped.h"
+#include "ros/ros.h"
+
+#include "drake_ros_systems/subscriber_system_base.h"
+
+namespace drake_ros_systems {
+
+using namespace drake;
+
+/**
+ * The latest wrench of one source of a RosWrenchSubscriberSystem, resolved
+ * to the plant body it acts on.
+ */
+struct BodyWrench {
+  /// Invalid until the source's first usable message.
+  multibody::BodyIndex body;
+
+  /// The application point, i.e. the origin of the message's frame.
+  Eigen::Vector3d p_BoBq_B{Eigen::Vector3d::Zero()};
+
+  /// Torque and force, expressed in the body frame.
+  Eigen::Vector3d torque_B{Eigen::Vector3d::Zero()};
+  Eigen::Vector3d force_B{Eigen::Vector3d::Zero()};
+};
+
+/**
+ * Receives `geometry_msgs/WrenchStamped` messages from any number of topics
+ * (teleoperation, disturbance generators, ...) and outputs them as the
+ * std::vector<multibody::ExternallyAppliedSpatialForce<double>> expected by
+ * MultibodyPlant::get_applied_spatial_force_input_port().
+ *
+ * Each topic added with AddWrenchTopic() owns one entry of a persistent
+ * vector of BodyWrench, kept in the State like the message of any other
+ * subscriber system. A message only rewrites its own entry: its header
+ * `frame_id` names a plant frame, resolved to the body it is attached to
+ * once and cached, and the wrench, applied at the frame's origin, is
+ * rotated into the body frame. A wrench stays applied until its topic
+ * delivers the next one. Frames are named `frame`, or `model_instance::frame`
+ * when several model instances have a frame of that name; messages naming
+ * an unknown or ambiguous frame are dropped.
+ *
+ * The output expresses the forces in the world frame, using the body poses
+ * from the input port, to be connected to
+ * MultibodyPlant::get_body_poses_output_port(). That is one rotation per
+ * active source; no name lookups or allocations happen per step.
+ */
+class RosWrenchSubscriberSystem
+    : public SubscriberSystemBase<std::vector<BodyWrench>> {
+ public:
+  DRAKE_NO_COPY_NO_MOVE_NO_ASSIGN(RosWrenchSubscriberSystem)
+
+  /**
+   * @param[in] plant The finalized plant the wrenches act on. Must outlive
+   * this system.
+   *
+   * @param node_handle The ROS context.
+   */
+  RosWrenchSubscriberSystem(const multibody::MultibodyPlant<double>& plant,
+                            ros::NodeHandle* node_handle)
+      : SubscriberSystemBase<std::vector<BodyWrench>>(false),
+        plant_(plant),
+        node_handle_(node_handle) {
+    DRAKE_DEMAND(node_handle_ != nullptr);
+    DRAKE_DEMAND(plant_.is_finalized());
+
+    body_poses_port_index_ = DeclareAbstractInputPort().get_index();
+    DeclareAbstractOutputPort(
+        [](const systems::Context<double>&) {
+          return systems::AbstractValue::Make(
+              std::vector<multibody::ExternallyAppliedSpatialForce<double>>());
+        },
+        [this](const systems::Context<double>& context,
+               systems::AbstractValue* out) {
+          this->CalcSpatialForces(
+              context,
+              &out->GetMutableValue<std::vector<
+                  multibody::ExternallyAppliedSpatialForce<double>>>());
+        });
+    set_name("RosWrenchSubscriberSystem");
+  }
+
+  ~RosWrenchSubscriberSystem() override {
+    for (ros::Subscriber& subscriber : subscribers_) subscriber.shutdown();
+  }
+
+  /// Input port for the plant's body poses, see
+  /// MultibodyPlant::get_body_poses_output_port().
+  const systems::InputPort<double>& get_body_poses_input_port() const {
+    return get_input_port(body_poses_port_index_);
+  }
+
+  /**
+   * Subscribes to wrenches on @p topic and returns the index of its entry.
+   * Must be called before the ROS callbacks are being spun.
+   */
+  int AddWrenchTopic(const std::string& topic) {
+    const int index = static_cast<int>(subscribers_.size());
+    subscribers_.push_back(
+        node_handle_->subscribe<geometry_msgs::WrenchStamped>(
+            topic, 10,
+            boost::bind(&RosWrenchSubscriberSystem::HandleWrench, this, _1,
+                        index)));
+    return index;
+  }
+
+  /// Returns the number of messages dropped because of an unknown or
+  /// ambiguous frame.
+  int get_dropped_message_count() const { return dropped_message_count_; }
+
+ private:
+  struct ResolvedFrame {
+    multibody::BodyIndex body;
+    Eigen::Matrix3d R_BF;
+    Eigen::Vector3d p_BF;
+  };
+
+  // Resolves `frame` or `model_instance::frame`. Returns nullptr if there is
+  // no such frame, or if an unqualified name is used by several model
+  // instances, rather than letting the plant throw into the ROS callback.
+  const multibody::Frame<double>* FindFrame(const std::string& frame_id) const {
+    const std::size_t separator = frame_id.rfind("::");
+    if (separator != std::string::npos) {
+      const std::string instance_name = frame_id.substr(0, separator);
+      const std::string frame_name = frame_id.substr(separator + 2);
+      if (!plant_.HasModelInstanceNamed(instance_name)) return nullptr;
+      const multibody::ModelInstanceIndex instance =
+          plant_.GetModelInstanceByName(instance_name);
+      if (!plant_.HasFrameNamed(frame_name, instance)) return nullptr;
+      return &plant_.GetFrameByName(frame_name, instance);
+    }
+    if (!plant_.HasFrameNamed(frame_id)) return nullptr;
+    try {
+      return &plant_.GetFrameByName(frame_id);
+    } catch (const std::logic_error&) {
+      return nullptr;
+    }
+  }
+
+  void HandleWrench(const geometry_msgs::WrenchStamped::ConstPtr& message,
+                    int index) {
+    const std::string& frame_id = message->header.frame_id;
+    const Eigen::Vector3d force_F(message->wrench.force.x,
+                                  message->wrench.force.y,
+                                  message->wrench.force.z);
+    const Eigen::Vector3d torque_F(message->wrench.torque.x,
+                                   message->wrench.torque.y,
+                                   message->wrench.torque.z);
+    ModifyMessage([&](std::vector<BodyWrench>* wrenches) {
+      // The receive buffer's lock also guards resolved_frames_.
+      auto it = resolved_frames_.find(frame_id);
+      if (it == resolved_frames_.end()) {
+        const multibody::Frame<double>* frame = FindFrame(frame_id);
+        if (frame == nullptr) {
+          ++dropped_message_count_;
+          ROS_WARN_THROTTLE(
+              1.0, "RosWrenchSubscriberSystem: unknown or ambiguous frame '%s'",
+              frame_id.c_str());
+          return false;
+        }
+        const math::RigidTransform<double> X_BF =
+            frame->GetFixedPoseInBodyFrame();
+        it = resolved_frames_
+                 .emplace(frame_id,
+                          ResolvedFrame{frame->body().index(),
+                                        X_BF.rotation().matrix(),
+                                        X_BF.translation()})
+                 .first;
+      }
+      const ResolvedFrame& resolved = it->second;
+      if (static_cast<int>(wrenches->size()) <= index)
+        wrenches->resize(index + 1);
+      BodyWrench& wrench = (*wrenches)[index];
+      wrench.body = resolved.body;
+      wrench.p_BoBq_B = resolved.p_BF;
+      wrench.torque_B = resolved.R_BF * torque_F;
+      wrench.force_B = resolved.R_BF * force_F;
+      return true;
+    });
+  }
+
+  void CalcSpatialForces(
+      const systems::Context<double>& context,
+      std::vector<multibody::ExternallyAppliedSpatialForce<double>>* forces)
+      const {
+    const std::vector<BodyWrench>& wrenches =
+        context.get_abstract_state<std::vector<BodyWrench>>(
+            kStateIndexMessage);
+    const systems::AbstractValue* poses_input =
+        EvalAbstractInput(context, body_poses_port_index_);
+    DRAKE_DEMAND(poses_input != nullptr);
+    const auto& X_WB_all =
+        poses_input->GetValue<std::vector<math::RigidTransform<double>>>();
+
+    forces->resize(wrenches.size());
+    int num_active = 0;
+    for (const BodyWrench& wrench : wrenches) {
+      if (!wrench.body.is_valid()) continue;
+      const Eigen::Matrix3d R_WB = X_WB_all[wrench.body].rotation().matrix();
+      multibody::ExternallyAppliedSpatialForce<double>& force =
+          (*forces)[num_active++];
+      force.body_index = wrench.body;
+      force.p_BoBq_B = wrench.p_BoBq_B;
+      force.F_Bq_W = multibody::SpatialForce<double>(R_WB * wrench.torque_B,
+                                                     R_WB * wrench.force_B);
+    }
+    forces->resize(num_active);
+  }
+
+  const multibody::MultibodyPlant<double>& plant_;
+  ros::NodeHandle* const node_handle_{};
+
+  int body_poses_port_index_{};
+
+  // Guarded by the receive buffer's lock, see HandleWrench().
+  std::map<std::string, ResolvedFrame> resolved_frames_;
+  std::atomic<int> dropped_message_count_{0};
+
+  std::vector<ros::Subscriber> subscribers_;
+};
+
+}  // namespace drake_ros_systems
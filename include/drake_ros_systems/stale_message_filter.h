@@ -0,0 +1,182 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <typeinfo>
+#include <utility>
+
+#include "boost/make_shared.hpp"
+#include "boost/shared_ptr.hpp"
+
+#include "drake/common/drake_assert.h"
+#include "drake/common/drake_copyable.h"
+
+#include "ros/message_event.h"
+#include "ros/ros.h"
+#include "ros/subscription_callback_helper.h"
+
+namespace drake_ros_systems {
+
+using namespace drake;
+
+/**
+ * Rejects messages whose header stamp is older than the newest accepted one
+ * by more than a horizon, and counts them. Thread safe.
+ */
+class StaleMessageFilter {
+ public:
+  DRAKE_NO_COPY_NO_MOVE_NO_ASSIGN(StaleMessageFilter)
+
+  /// @param[in] horizon How far behind the newest accepted stamp a message
+  /// may be, in seconds.
+  explicit StaleMessageFilter(double horizon) : horizon_(horizon) {
+    DRAKE_DEMAND(horizon >= 0.0);
+  }
+
+  double get_horizon() const { return horizon_.toSec(); }
+
+  /// Returns whether a message stamped @p stamp would be rejected.
+  bool IsStale(const ros::Time& stamp) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return IsStaleLocked(stamp);
+  }
+
+  /// Accepts a message stamped @p stamp, advancing the newest stamp, unless
+  /// it is stale. Returns false and counts it otherwise.
+  bool Accept(const ros::Time& stamp) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (IsStaleLocked(stamp)) {
+      ++stale_count_;
+      return false;
+    }
+    if (!has_newest_ || stamp > newest_) newest_ = stamp;
+    has_newest_ = true;
+    return true;
+  }
+
+  /// Counts a message rejected by IsStale() without calling Accept().
+  void CountStale() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    ++stale_count_;
+  }
+
+  /// Returns the number of messages rejected so far.
+  int get_stale_count() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return stale_count_;
+  }
+
+ private:
+  bool IsStaleLocked(const ros::Time& stamp) const {
+    // Stamps are non-negative, so compare as stamp + horizon < newest.
+    return has_newest_ && stamp + horizon_ < newest_;
+  }
+
+  const ros::Duration horizon_;
+
+  // The mutex that guards everything below.
+  mutable std::mutex mutex_;
+  bool has_newest_{false};
+  ros::Time newest_;
+  int stale_count_{0};
+};
+
+/**
+ * A roscpp subscription callback helper for message type @p RosMessage, which
+ * must have a header, that consults a StaleMessageFilter before doing any
+ * work on a message.
+ *
+ * Serialized messages start with their std_msgs/Header, whose stamp follows
+ * the 4-byte sequence number. deserialize() peeks at those 8 bytes and drops
+ * stale messages before allocating or deserializing anything. Intra-process
+ * messages arrive already instantiated, so they are only checked in call(),
+ * which also advances the filter before invoking the callback.
+ */
+template <typename RosMessage>
+class StaleMessageFilterCallbackHelper
+    : public ros::SubscriptionCallbackHelper {
+ public:
+  using Callback = std::function<void(const boost::shared_ptr<RosMessage>&)>;
+
+  /// @p filter must outlive the subscription.
+  StaleMessageFilterCallbackHelper(StaleMessageFilter* filter,
+                                   Callback callback)
+      : filter_(filter), callback_(std::move(callback)) {
+    DRAKE_DEMAND(filter_ != nullptr);
+  }
+
+  ros::VoidConstPtr deserialize(
+      const ros::SubscriptionCallbackHelperDeserializeParams& params)
+      override {
+    const std::uint32_t kStampOffset = 4;
+    if (params.length >= kStampOffset + 8) {
+      const std::uint8_t* const stamp = params.buffer + kStampOffset;
+      const ros::Time time(ReadU32(stamp), ReadU32(stamp + 4));
+      if (filter_->IsStale(time)) {
+        filter_->CountStale();
+        // A null message makes roscpp skip call().
+        return ros::VoidConstPtr();
+      }
+    }
+
+    namespace ser = ros::serialization;
+    const boost::shared_ptr<RosMessage> message =
+        boost::make_shared<RosMessage>();
+    ser::PreDeserializeParams<RosMessage> pre_params;
+    pre_params.message = message;
+    pre_params.connection_header = params.connection_header;
+    ser::PreDeserialize<RosMessage>::notify(pre_params);
+    ser::IStream stream(params.buffer, params.length);
+    ser::deserialize(stream, *message);
+    return ros::VoidConstPtr(message);
+  }
+
+  // The callback takes the message by pointer to non-const, which roscpp
+  // copies only if another callback shares it.
+  void call(ros::SubscriptionCallbackHelperCallParams& params) override {
+    const ros::MessageEvent<RosMessage> event(
+        params.event, ros::DefaultMessageCreator<RosMessage>());
+    const boost::shared_ptr<RosMessage> message = event.getMessage();
+    if (filter_->Accept(message->header.stamp)) callback_(message);
+  }
+
+  const std::type_info& getTypeInfo() override { return typeid(RosMessage); }
+
+  bool isConst() override { return false; }
+
+  bool hasHeader() override { return true; }
+
+ private:
+  static std::uint32_t ReadU32(const std::uint8_t* data) {
+    return std::uint32_t{data[0]} | (std::uint32_t{data[1]} << 8) |
+           (std::uint32_t{data[2]} << 16) | (std::uint32_t{data[3]} << 24);
+  }
+
+  StaleMessageFilter* const filter_{};
+  const Callback callback_;
+};
+
+/**
+ * Returns options to subscribe to @p topic with a
+ * StaleMessageFilterCallbackHelper in front of @p callback.
+ */
+template <typename RosMessage>
+ros::SubscribeOptions MakeStaleMessageFilterSubscribeOptions(
+    const std::string& topic, uint32_t queue_size, StaleMessageFilter* filter,
+    typename StaleMessageFilterCallbackHelper<RosMessage>::Callback callback) {
+  static_assert(ros::message_traits::HasHeader<RosMessage>::value,
+                "Stale messages are detected by their header stamps");
+  ros::SubscribeOptions options;
+  options.topic = topic;
+  options.queue_size = queue_size;
+  options.md5sum = ros::message_traits::md5sum<RosMessage>();
+  options.datatype = ros::message_traits::datatype<RosMessage>();
+  options.helper =
+      boost::make_shared<StaleMessageFilterCallbackHelper<RosMessage>>(
+          filter, std::move(callback));
+  return options;
+}
+
+}  // namespace drake_ros_systems
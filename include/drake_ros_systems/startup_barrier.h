@@ -0,0 +1,187 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "drake/common/drake_assert.h"
+#include "drake/common/drake_copyable.h"
+
+#include "drake_ros_systems/subscriber_system_base.h"
+
+namespace drake_ros_systems {
+
+using namespace drake;
+
+/**
+ * Readiness of one topic at the end of StartupBarrier::Wait().
+ */
+struct StartupTopicStatus {
+  /// The name of the system, which includes its topic.
+  std::string name;
+
+  /// Whether the system publishes (and waits for subscribers) rather than
+  /// subscribes (and waits for a first message).
+  bool is_publisher{false};
+
+  /// Messages received, or subscribers connected, when last checked.
+  int count{0};
+
+  /// The count at which the topic is ready.
+  int required{0};
+
+  bool ready{false};
+
+  /// Seconds from the start of Wait() until the topic was first seen ready;
+  /// negative if it never was.
+  double ready_after{-1.0};
+};
+
+/**
+ * Outcome of StartupBarrier::Wait().
+ */
+struct StartupReport {
+  /// Whether every topic became ready before the deadline.
+  bool all_ready{false};
+
+  /// Seconds spent in Wait().
+  double elapsed{0.0};
+
+  std::vector<StartupTopicStatus> topics;
+
+  /// Returns one line per topic, e.g. for logging a slow start.
+  std::string ToString() const {
+    std::ostringstream out;
+    out << std::fixed << std::setprecision(3);
+    out << (all_ready ? "ready" : "NOT ready") << " after " << elapsed
+        << " s";
+    for (const StartupTopicStatus& topic : topics) {
+      out << "\n  " << topic.name << ": "
+          << (topic.is_publisher ? "subscribers " : "messages ")
+          << topic.count << "/" << topic.required;
+      if (topic.ready) {
+        out << ", ready after " << topic.ready_after << " s";
+      } else {
+        out << ", NOT ready";
+      }
+    }
+    return out.str();
+  }
+};
+
+/**
+ * Holds off the start of a simulation until its ROS connections are up: every
+ * added subscriber has received a first message and every added publisher has
+ * its expected number of subscribers.
+ *
+ * All conditions are checked together against one deadline, so the total
+ * wait is bounded by the slowest topic, not by the sum of per-topic
+ * timeouts. The ROS callbacks must be spun by another thread, e.g. a
+ * ros::AsyncSpinner, while Wait() blocks.
+ *
+ * Subscriber systems copy their received value into the State when the
+ * Context is created (see SubscriberSystemBase::SetDefaultState()). Call
+ * Wait() before constructing the Simulator, so that the first step sees the
+ * first messages instead of default-constructed ones; or use a
+ * SubscriberPoller on the existing Context afterwards.
+ */
+class StartupBarrier {
+ public:
+  DRAKE_NO_COPY_NO_MOVE_NO_ASSIGN(StartupBarrier)
+
+  StartupBarrier() {}
+
+  /// Requires a first message on @p subscriber.
+  template <typename T>
+  void AddSubscriber(const SubscriberSystemBase<T>& subscriber) {
+    const SubscriberSystemBase<T>* system = &subscriber;
+    AddCondition(subscriber.get_name(), false, 1,
+                 [system]() { return system->GetReceivedMessageCount(); });
+  }
+
+  /**
+   * Requires at least @p min_subscribers connected to @p publisher, which
+   * must provide get_name() and get_num_subscribers(), like
+   * RosPublisherSystem.
+   */
+  template <typename Publisher>
+  void AddPublisher(const Publisher& publisher, int min_subscribers = 1) {
+    DRAKE_DEMAND(min_subscribers >= 1);
+    const Publisher* system = &publisher;
+    AddCondition(publisher.get_name(), true, min_subscribers,
+                 [system]() { return system->get_num_subscribers(); });
+  }
+
+  /**
+   * Blocks until every topic is ready or @p timeout seconds have passed,
+   * checking all of them every @p poll_period seconds. Returns the
+   * per-topic report either way.
+   */
+  StartupReport Wait(double timeout, double poll_period = 0.005) const {
+    DRAKE_DEMAND(timeout >= 0.0 && poll_period > 0.0);
+    using Clock = std::chrono::steady_clock;
+    const Clock::time_point start = Clock::now();
+    const Clock::time_point deadline =
+        start + std::chrono::duration_cast<Clock::duration>(
+                    std::chrono::duration<double>(timeout));
+    const auto period = std::chrono::duration_cast<Clock::duration>(
+        std::chrono::duration<double>(poll_period));
+    auto seconds_since_start = [&start](Clock::time_point time) {
+      return std::chrono::duration<double>(time - start).count();
+    };
+
+    StartupReport report;
+    report.topics.resize(conditions_.size());
+    for (std::size_t i = 0; i < conditions_.size(); ++i) {
+      report.topics[i].name = conditions_[i].name;
+      report.topics[i].is_publisher = conditions_[i].is_publisher;
+      report.topics[i].required = conditions_[i].required;
+    }
+
+    while (true) {
+      const Clock::time_point now = Clock::now();
+      bool all_ready = true;
+      for (std::size_t i = 0; i < conditions_.size(); ++i) {
+        StartupTopicStatus& topic = report.topics[i];
+        if (topic.ready) continue;
+        topic.count = conditions_[i].count();
+        if (topic.count >= topic.required) {
+          topic.ready = true;
+          topic.ready_after = seconds_since_start(now);
+        } else {
+          all_ready = false;
+        }
+      }
+      if (all_ready || now >= deadline) {
+        report.all_ready = all_ready;
+        report.elapsed = seconds_since_start(now);
+        return report;
+      }
+      std::this_thread::sleep_until(std::min(now + period, deadline));
+    }
+  }
+
+ private:
+  struct Condition {
+    std::string name;
+    bool is_publisher;
+    int required;
+    std::function<int()> count;
+  };
+
+  void AddCondition(const std::string& name, bool is_publisher, int required,
+                    std::function<int()> count) {
+    conditions_.push_back(
+        Condition{name, is_publisher, required, std::move(count)});
+  }
+
+  std::vector<Condition> conditions_;
+};
+
+}  // namespace drake_ros_systems
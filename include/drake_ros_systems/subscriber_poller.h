@@ -0,0 +1,100 @@
+#pragma once
+
+#include <functional>
+#include <vector>
+
+#include "drake/common/drake_copyable.h"
+#include "drake/systems/framework/context.h"
+#include "drake/systems/framework/diagram.h"
+#include "drake/systems/framework/system.h"
+
+#include "drake_ros_systems/subscriber_system_base.h"
+
+namespace drake_ros_systems {
+
+using namespace drake;
+
+/**
+ * Updates the latest-value State of a set of subscriber systems in one call,
+ * for control loops that evaluate a System without a Simulator.
+ *
+ * The subsystem contexts are resolved once, when a subscriber is added, so
+ * Poll() only takes each subscriber's lock, compares message counters and
+ * copies the values that are new: it neither allocates nor goes through
+ * CalcNextUpdateTime() and the event collections.
+ *
+ * @code
+ * SubscriberPoller poller(*diagram, context.get());
+ * const int state = poller.AddSubscriber(*state_subscriber);
+ * ros::Rate rate(2000);
+ * while (ros::ok()) {
+ *   poller.Poll();
+ *   if (poller.has_changed(state)) { ... evaluate outputs ... }
+ *   rate.sleep();
+ * }
+ * @endcode
+ */
+class SubscriberPoller {
+ public:
+  DRAKE_NO_COPY_NO_MOVE_NO_ASSIGN(SubscriberPoller)
+
+  /**
+   * @param[in] root_system The system whose Context is @p root_context. It
+   * is either a subscriber itself or a Diagram containing the subscribers.
+   *
+   * @param root_context The Context to update. Must outlive this poller.
+   */
+  SubscriberPoller(const systems::System<double>& root_system,
+                   systems::Context<double>* root_context)
+      : root_system_(root_system), root_context_(root_context) {
+    DRAKE_DEMAND(root_context_ != nullptr);
+  }
+
+  /**
+   * Adds @p subscriber, which must be @p root_system or one of its
+   * subsystems, and returns its index for has_changed().
+   */
+  template <typename T>
+  int AddSubscriber(const SubscriberSystemBase<T>& subscriber) {
+    systems::Context<double>* context = root_context_;
+    if (&subscriber != &root_system_) {
+      const auto* diagram =
+          dynamic_cast<const systems::Diagram<double>*>(&root_system_);
+      DRAKE_DEMAND(diagram != nullptr);
+      context = &diagram->GetMutableSubsystemContext(subscriber, root_context_);
+    }
+    const SubscriberSystemBase<T>* system = &subscriber;
+    updates_.push_back([system, context]() {
+      return system->UpdateStateIfNewMessage(context);
+    });
+    changed_.push_back(false);
+    return static_cast<int>(updates_.size()) - 1;
+  }
+
+  /**
+   * Stores every newly received value in the Context. Returns the number of
+   * subscribers whose State changed.
+   */
+  int Poll() {
+    int num_changed = 0;
+    for (std::size_t i = 0; i < updates_.size(); ++i) {
+      changed_[i] = updates_[i]();
+      if (changed_[i]) ++num_changed;
+    }
+    return num_changed;
+  }
+
+  /// Returns whether the subscriber at @p index changed in the last Poll().
+  bool has_changed(int index) const { return changed_.at(index); }
+
+  int num_subscribers() const { return static_cast<int>(updates_.size()); }
+
+ private:
+  const systems::System<double>& root_system_;
+  systems::Context<double>* const root_context_{};
+
+  std::vector<std::function<bool()>> updates_;
+  std::vector<bool> changed_;
+};
+
+}  // namespace drake_ros_systems
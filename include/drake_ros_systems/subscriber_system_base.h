@@ -0,0 +1,252 @@
+#pragma once
+
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include "drake/common/drake_copyable.h"
+#include "drake/systems/framework/leaf_system.h"
+
+namespace drake_ros_systems {
+
+using namespace drake;
+
+/**
+ * Common machinery of the subscriber systems: stores the most recently
+ * received value of type T in the State and outputs it on the sole
+ * abstract-valued output port.
+ *
+ * Derived classes hook into their transport and call HandleMessage() from
+ * its callback threads. When a value arrives asynchronously, an update event
+ * is scheduled to store it in the State at the earliest possible simulation
+ * time. The output is always consistent with the State.
+ *
+ * To process a value, CalcNextUpdateTime() needs to be called first to
+ * check for new values and schedule a callback event if one has arrived. The
+ * value is then stored in the Context by CalcUnrestrictedUpdate(). When this
+ * system is evaluated by the Simulator, all these operations are taken care
+ * of by the Simulator. On the other hand, the user needs to manually
+ * replicate this process without the Simulator, or call
+ * UpdateStateIfNewMessage().
+ *
+ * @tparam T type of the value on the output port. Must be default
+ * constructible and copyable.
+ */
+template <typename T>
+class SubscriberSystemBase : public systems::LeafSystem<double> {
+ public:
+  DRAKE_NO_COPY_NO_MOVE_NO_ASSIGN(SubscriberSystemBase)
+
+  ~SubscriberSystemBase() override{};
+
+  /**
+   * Blocks the caller until @p old_message_count is different from the
+   * internal message counter, and the internal message counter is returned.
+   */
+  int WaitForMessage(int old_message_count) const {
+    // The message buffer and counter are updated in HandleMessage(), which is
+    // a callback function invoked by a potentially different thread. Thus,
+    // for thread safety, these need to be properly protected by a mutex.
+    std::unique_lock<std::mutex> lock(received_message_mutex_);
+
+    // This while loop is necessary to guard for spurious wakeup:
+    // https://en.wikipedia.org/wiki/Spurious_wakeup
+    while (old_message_count == received_message_count_)
+      // When wait returns, lock is atomically acquired. So it's thread safe to
+      // read received_message_count_.
+      received_message_condition_variable_.wait(lock);
+    int new_message_count = received_message_count_;
+    lock.unlock();
+
+    return new_message_count;
+  }
+
+  /**
+   * Returns the internal message counter, i.e. the number of values received
+   * so far, whether or not they have been stored in a Context yet.
+   */
+  int GetReceivedMessageCount() const {
+    std::lock_guard<std::mutex> lock(received_message_mutex_);
+    return received_message_count_;
+  }
+
+  /**
+   * Copies the receive buffer, i.e. the most recently received value, into
+   * @p message and returns the internal message counter, e.g. to checkpoint
+   * them.
+   */
+  int GetReceivedMessage(T* message) const {
+    DRAKE_DEMAND(message != nullptr);
+    std::lock_guard<std::mutex> lock(received_message_mutex_);
+    *message = received_message_;
+    return received_message_count_;
+  }
+
+  /**
+   * Replaces the receive buffer and the internal message counter, e.g. when
+   * restoring a checkpoint. Values arriving from the transport afterwards
+   * are handled as usual.
+   */
+  void SetReceivedMessage(const T& message, int message_count) {
+    std::lock_guard<std::mutex> lock(received_message_mutex_);
+    received_message_ = message;
+    received_message_count_ = message_count;
+    received_message_condition_variable_.notify_all();
+  }
+
+  /**
+   * Returns the message counter stored in @p context.
+   */
+  int GetMessageCount(const systems::Context<double>& context) const {
+    // Gets the last message count from abstract state.
+    return context.get_abstract_state<int>(kStateIndexMessageCount);
+  }
+
+  /**
+   * Stores the most recently received value in @p context if it is newer than
+   * the one already there, bypassing the event machinery. Returns whether the
+   * State changed. This is what the Simulator achieves through
+   * CalcNextUpdateTime() and CalcUnrestrictedUpdate(), for loops that drive
+   * the system without one; see SubscriberPoller.
+   */
+  bool UpdateStateIfNewMessage(systems::Context<double>* context) const {
+    DRAKE_DEMAND(context != nullptr);
+    const int last_message_count = GetMessageCount(*context);
+    std::lock_guard<std::mutex> lock(received_message_mutex_);
+    if (last_message_count == received_message_count_) return false;
+    context->template get_mutable_abstract_state<T>(kStateIndexMessage) =
+        received_message_;
+    context->template get_mutable_abstract_state<int>(
+        kStateIndexMessageCount) = received_message_count_;
+    return true;
+  }
+
+ protected:
+  // Derived classes that output something other than the stored value pass
+  // false and declare their own output ports.
+  explicit SubscriberSystemBase(bool declare_output_port = true) {
+    if (!declare_output_port) return;
+    DeclareAbstractOutputPort(
+        [this](const systems::Context<double>&) {
+          return this->AllocateOutputValue();
+        },
+        [this](const systems::Context<double>& context,
+               systems::AbstractValue* out) {
+          this->CalcOutputValue(context, out);
+        });
+  }
+
+  void DoCalcNextUpdateTime(const systems::Context<double>& context,
+                            systems::CompositeEventCollection<double>* events,
+                            double* time) const override {
+    const int last_message_count = GetMessageCount(context);
+
+    const int received_message_count = [this]() {
+      std::unique_lock<std::mutex> lock(received_message_mutex_);
+      return received_message_count_;
+    }();
+
+    // Has a new message. Schedule an update event.
+    if (last_message_count != received_message_count) {
+      // TODO(siyuan): should be context.get_time() once #5725 is resolved.
+      *time = context.get_time() + 0.0001;
+
+      systems::EventCollection<systems::UnrestrictedUpdateEvent<double>>&
+          uu_events = events->get_mutable_unrestricted_update_events();
+      uu_events.add_event(
+          std::make_unique<systems::UnrestrictedUpdateEvent<double>>(
+              systems::Event<double>::TriggerType::kTimed));
+    }
+  }
+
+  void DoCalcUnrestrictedUpdate(
+      const systems::Context<double>&,
+      const std::vector<const systems::UnrestrictedUpdateEvent<double>*>&,
+      systems::State<double>* state) const override {
+    ProcessMessageAndStoreToAbstractState(&state->get_mutable_abstract_state());
+  }
+
+  std::unique_ptr<systems::AbstractValues> AllocateAbstractState()
+      const override {
+    std::vector<std::unique_ptr<systems::AbstractValue>> abstract_vals(2);
+    abstract_vals[kStateIndexMessage] =
+        this->SubscriberSystemBase::AllocateOutputValue();
+    abstract_vals[kStateIndexMessageCount] =
+        systems::AbstractValue::Make<int>(0);
+    return std::make_unique<systems::AbstractValues>(std::move(abstract_vals));
+  }
+
+  void SetDefaultState(const systems::Context<double>& context,
+                       systems::State<double>* state) const override {
+    ProcessMessageAndStoreToAbstractState(&state->get_mutable_abstract_state());
+  };
+
+  // Stores a value received by the transport. Also wakes up every thread
+  // blocked in WaitForMessage().
+  void HandleMessage(const T& message) {
+    std::lock_guard<std::mutex> lock(received_message_mutex_);
+    received_message_ = message;
+    received_message_count_++;
+    received_message_condition_variable_.notify_all();
+  }
+
+  // Same as above, but swaps @p message into the receive buffer instead of
+  // copying it. On return @p message holds the previously received value, so
+  // derived classes that convert into a scratch value can reuse its storage.
+  void HandleMessage(T* message) {
+    std::lock_guard<std::mutex> lock(received_message_mutex_);
+    using std::swap;
+    swap(received_message_, *message);
+    received_message_count_++;
+    received_message_condition_variable_.notify_all();
+  }
+
+  // Same as above, but lets @p modify change the receive buffer in place,
+  // e.g. to update one entry of a container. @p modify returns whether it
+  // changed anything; if not, nothing counts as received.
+  template <typename Modify>
+  void ModifyMessage(Modify modify) {
+    std::lock_guard<std::mutex> lock(received_message_mutex_);
+    if (!modify(&received_message_)) return;
+    received_message_count_++;
+    received_message_condition_variable_.notify_all();
+  }
+
+  constexpr static int kStateIndexMessage = 0;
+  constexpr static int kStateIndexMessageCount = 1;
+
+ private:
+  void ProcessMessageAndStoreToAbstractState(
+      systems::AbstractValues* abstract_state) const {
+    std::lock_guard<std::mutex> lock(received_message_mutex_);
+    abstract_state->get_mutable_value(kStateIndexMessage)
+        .GetMutableValue<T>() = received_message_;
+    abstract_state->get_mutable_value(kStateIndexMessageCount)
+        .GetMutableValue<int>() = received_message_count_;
+  };
+
+  std::unique_ptr<systems::AbstractValue> AllocateOutputValue() const {
+    return std::make_unique<systems::Value<T>>(T{});
+  }
+  void CalcOutputValue(const systems::Context<double>& context,
+                       systems::AbstractValue* output_value) const {
+    output_value->SetFrom(
+        context.get_abstract_state().get_value(kStateIndexMessage));
+  }
+
+  // The mutex that guards received_message_ and received_message_count_.
+  mutable std::mutex received_message_mutex_;
+
+  // A condition variable that's signaled every time the handler is called.
+  mutable std::condition_variable received_message_condition_variable_;
+
+  // The most recently received value.
+  T received_message_{};
+
+  // A message counter that's incremented every time the handler is called.
+  int received_message_count_{0};
+};
+
+}  // namespace drake_ros_systems
@@ -0,0 +1,53 @@
+#include <memory>
+#include "drake/systems/analysis/simulator.h"
+#include "drake/systems/framework/diagram.h"
+#include "drake/systems/framework/diagram_builder.h"
+#include "ros/ros.h"
+#include "sensor_msgs/Image.h"
+
+#include "../include/drake_ros_systems/adaptive_spinner.h"
+#include "../include/drake_ros_systems/ros_image_subscriber_system.h"
+
+using drake::systems::DiagramBuilder;
+using drake::systems::Simulator;
+
+using namespace drake_ros_systems;
+
+// Services "test_spinner_image" and "test_spinner_image2" with 1 to 8
+// threads and reports the spinner's decisions every second.
+int DoMain(ros::NodeHandle& node_handle) {
+  DiagramBuilder<double> builder;
+
+  builder.AddSystem(std::make_unique<RosImageSubscriberSystem>(
+      "test_spinner_image", &node_handle));
+  builder.AddSystem(std::make_unique<RosImageSubscriberSystem>(
+      "test_spinner_image2", &node_handle));
+
+  auto sys = builder.Build();
+  Simulator<double> simulator(*sys);
+
+  AdaptiveSpinnerOptions options;
+  options.max_threads = 8;
+  AdaptiveSpinner spinner(options);
+  spinner.start();
+
+  simulator.Initialize();
+  simulator.set_target_realtime_rate(1.0);
+  while (ros::ok()) {
+    simulator.StepTo(simulator.get_context().get_time() + 1.0);
+    const AdaptiveSpinnerStats stats = spinner.get_stats();
+    ROS_INFO("threads %d, busy %.2f, callbacks %lu, last decision: %s",
+             stats.num_threads, stats.busy_fraction,
+             static_cast<unsigned long>(stats.num_callbacks),
+             stats.last_decision.c_str());
+  }
+
+  return 0;
+}
+
+int main(int argc, char* argv[]) {
+  ros::init(argc, argv, "test_adaptive_spinner");
+  ros::NodeHandle node_handle;
+
+  return DoMain(node_handle);
+}
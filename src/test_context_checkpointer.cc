@@ -0,0 +1,66 @@
+#include <memory>
+#include "drake/systems/analysis/simulator.h"
+#include "drake/systems/framework/diagram.h"
+#include "drake/systems/framework/diagram_builder.h"
+#include "ros/ros.h"
+#include "std_msgs/String.h"
+
+#include "../include/drake_ros_systems/context_checkpointer.h"
+#include "../include/drake_ros_systems/ros_subscriber_system.h"
+
+using drake::systems::DiagramBuilder;
+using drake::systems::Simulator;
+
+using namespace drake_ros_systems;
+
+// Simulates 5 s, checkpoints, simulates 5 s more and then rewinds to the
+// checkpoint, twice over.
+int DoMain(ros::NodeHandle& node_handle) {
+  DiagramBuilder<double> builder;
+
+  auto msg_subscriber =
+      builder.AddSystem(RosSubscriberSystem<std_msgs::String>::Make(
+          "test_checkpoint", &node_handle));
+
+  auto sys = builder.Build();
+  Simulator<double> simulator(*sys);
+
+  ContextCheckpointer checkpointer;
+  checkpointer.RegisterRosMessage<std_msgs::String>();
+  checkpointer.AddSubscriber(msg_subscriber);
+
+  ros::AsyncSpinner spinner(1);
+  spinner.start();
+
+  simulator.Initialize();
+  simulator.set_target_realtime_rate(1.0);
+  simulator.StepTo(5.0);
+
+  const std::string filename = "/tmp/test_context_checkpointer.bin";
+  if (!checkpointer.SaveToFile(filename, simulator.get_context())) {
+    ROS_ERROR("Cannot write %s", filename.c_str());
+    return 1;
+  }
+
+  for (int run = 0; run < 2; ++run) {
+    simulator.StepTo(simulator.get_context().get_time() + 5.0);
+    const ros::WallTime start = ros::WallTime::now();
+    if (!checkpointer.RestoreFromFile(filename,
+                                      &simulator.get_mutable_context())) {
+      ROS_ERROR("Cannot restore %s", filename.c_str());
+      return 1;
+    }
+    ROS_INFO("Restored t = %f in %f s", simulator.get_context().get_time(),
+             (ros::WallTime::now() - start).toSec());
+    simulator.Initialize();
+  }
+
+  return 0;
+}
+
+int main(int argc, char* argv[]) {
+  ros::init(argc, argv, "test_context_checkpointer");
+  ros::NodeHandle node_handle;
+
+  return DoMain(node_handle);
+}
@@ -0,0 +1,72 @@
+#include <memory>
+#include "drake/systems/analysis/simulator.h"
+#include "drake/systems/framework/diagram.h"
+#include "drake/systems/framework/diagram_builder.h"
+#include "drake/systems/primitives/constant_value_source.h"
+#include "ros/ros.h"
+#include "std_msgs/String.h"
+
+#include "../include/drake_ros_systems/cosimulation_barrier.h"
+#include "../include/drake_ros_systems/ros_publisher_system.h"
+#include "../include/drake_ros_systems/ros_subscriber_system.h"
+
+using drake::systems::AbstractValue;
+using drake::systems::ConstantValueSource;
+using drake::systems::DiagramBuilder;
+using drake::systems::Simulator;
+
+using namespace drake_ros_systems;
+
+// Run as "test_cosimulation_barrier a b" and "test_cosimulation_barrier b a".
+// Each process publishes to, and subscribes from, the other one, and both
+// advance to t = 10 s in lockstep as fast as they can. Every message is
+// received one lookahead window after it was published, in every run.
+int DoMain(ros::NodeHandle& node_handle, const std::string& name,
+           const std::string& peer) {
+  const double kPublishPeriod = 0.1;
+
+  // Created first, since the bridge subscriber uses its node handle.
+  CoSimulationBarrier barrier(name, {peer}, &node_handle);
+  barrier.AddPublishPeriod(kPublishPeriod);
+
+  DiagramBuilder<double> builder;
+
+  auto msg_publisher =
+      builder.AddSystem(RosPublisherSystem<std_msgs::String>::Make(
+          "test_cosimulation/" + name, &node_handle));
+  msg_publisher->set_publish_period(kPublishPeriod);
+  barrier.AddPublisher(*msg_publisher);
+
+  std_msgs::String msg;
+  msg.data = "Hello from " + name;
+
+  auto msg_source =
+      builder.AddSystem(std::make_unique<ConstantValueSource<double>>(
+          AbstractValue::Make<std_msgs::String>(msg)));
+  builder.Connect(msg_source->get_output_port(0),
+                  msg_publisher->get_input_port(0));
+
+  const std::string peer_topic = "test_cosimulation/" + peer;
+  builder.AddSystem(RosSubscriberSystem<std_msgs::String>::Make(
+      peer_topic, barrier.GetSubscriberNodeHandle(peer_topic)));
+
+  auto sys = builder.Build();
+  Simulator<double> simulator(*sys);
+
+  simulator.Initialize();
+  return barrier.AdvanceTo(&simulator, 10.0) ? 0 : 1;
+}
+
+int main(int argc, char* argv[]) {
+  ros::init(argc, argv, "test_cosimulation_barrier",
+            ros::init_options::AnonymousName);
+  ros::NodeHandle node_handle;
+  ros::AsyncSpinner spinner(1);
+  spinner.start();
+
+  if (argc < 3) {
+    ROS_ERROR("usage: test_cosimulation_barrier <name> <peer>");
+    return 1;
+  }
+  return DoMain(node_handle, argv[1], argv[2]);
+}
@@ -0,0 +1,61 @@
+#include <cstdlib>
+#include <limits>
+#include <memory>
+#include "drake/systems/analysis/simulator.h"
+#include "drake/systems/framework/diagram.h"
+#include "drake/systems/primitives/constant_value_source.h"
+#include "ros/ros.h"
+#include "std_msgs/String.h"
+
+#include "../include/drake_ros_systems/diagram_partitioner.h"
+#include "../include/drake_ros_systems/ros_publisher_system.h"
+
+using drake::systems::AbstractValue;
+using drake::systems::ConstantValueSource;
+using drake::systems::Simulator;
+
+using namespace drake_ros_systems;
+
+// Run once with argument 0 and once with argument 1. Partition 0 owns the
+// message source, partition 1 republishes what it receives on
+// "test_partitioned_echo".
+int DoMain(ros::NodeHandle& node_handle, int partition) {
+  DiagramPartitioner partitioner(partition, &node_handle);
+
+  std_msgs::String msg;
+  msg.data = "Hello from partition 0!";
+
+  auto msg_source = partitioner.AddSystem(0, [&msg]() {
+    return std::make_unique<ConstantValueSource<double>>(
+        AbstractValue::Make<std_msgs::String>(msg));
+  });
+
+  auto msg_echo = partitioner.AddSystem(1, [&node_handle]() {
+    auto echo = RosPublisherSystem<std_msgs::String>::Make(
+        "test_partitioned_echo", &node_handle);
+    echo->set_publish_period(0.25);
+    return echo;
+  });
+
+  partitioner.Connect<std_msgs::String>(msg_source, 0, msg_echo, 0, 0.25);
+
+  auto sys = partitioner.Build();
+  Simulator<double> simulator(*sys);
+
+  simulator.Initialize();
+  simulator.set_target_realtime_rate(1.0);
+  simulator.StepTo(std::numeric_limits<double>::infinity());
+
+  return 0;
+}
+
+int main(int argc, char* argv[]) {
+  ros::init(argc, argv, "test_diagram_partitioner",
+            ros::init_options::AnonymousName);
+  ros::NodeHandle node_handle;
+  ros::AsyncSpinner spinner(1);
+  spinner.start();
+
+  const int partition = argc > 1 ? std::atoi(argv[1]) : 0;
+  return DoMain(node_handle, partition);
+}
@@ -0,0 +1,67 @@
+#include <memory>
+#include "controller_manager/controller_manager.h"
+#include "drake/multibody/plant/multibody_plant.h"
+#include "drake/multibody/tree/revolute_joint.h"
+#include "drake/systems/analysis/simulator.h"
+#include "drake/systems/framework/diagram.h"
+#include "drake/systems/framework/diagram_builder.h"
+#include "ros/ros.h"
+
+#include "../include/drake_ros_systems/drake_robot_hw.h"
+
+using drake::multibody::MultibodyPlant;
+using drake::multibody::RevoluteJoint;
+using drake::multibody::SpatialInertia;
+using drake::multibody::UnitInertia;
+using drake::systems::DiagramBuilder;
+using drake::systems::Simulator;
+
+using namespace drake_ros_systems;
+
+// Runs a controller_manager at 1 kHz against an actuated 1 m pendulum whose
+// joint is called "pin". Controllers are loaded as usual, e.g. a
+// joint_state_controller and an effort_controllers/JointPositionController.
+int DoMain(ros::NodeHandle& node_handle) {
+  DiagramBuilder<double> builder;
+
+  auto plant = builder.AddSystem(std::make_unique<MultibodyPlant<double>>());
+  const Eigen::Vector3d p_BoBcm(0.0, 0.0, -1.0);
+  const auto& arm = plant->AddRigidBody(
+      "arm", SpatialInertia<double>(1.0, p_BoBcm,
+                                    UnitInertia<double>::PointMass(p_BoBcm)));
+  const auto& pin = plant->AddJoint<RevoluteJoint>(
+      "pin", plant->world_body(), {}, arm, {}, Eigen::Vector3d::UnitY());
+  plant->AddJointActuator("pin_motor", pin);
+  plant->Finalize();
+
+  auto sys = builder.Build();
+  Simulator<double> simulator(*sys);
+
+  DrakeRobotHW hw(*plant, &sys->GetMutableSubsystemContext(
+                              *plant, &simulator.get_mutable_context()));
+  controller_manager::ControllerManager controller_manager(&hw, node_handle);
+
+  // Services the controller_manager's services and topics.
+  ros::AsyncSpinner spinner(1);
+  spinner.start();
+
+  simulator.Initialize();
+  simulator.set_target_realtime_rate(1.0);
+  const ros::Duration period(0.001);
+  while (ros::ok()) {
+    const ros::Time time(simulator.get_context().get_time());
+    hw.read(time, period);
+    controller_manager.update(time, period);
+    hw.write(time, period);
+    simulator.StepTo(simulator.get_context().get_time() + period.toSec());
+  }
+
+  return 0;
+}
+
+int main(int argc, char* argv[]) {
+  ros::init(argc, argv, "test_drake_robot_hw");
+  ros::NodeHandle node_handle;
+
+  return DoMain(node_handle);
+}
@@ -0,0 +1,49 @@
+#include <memory>
+#include "drake/systems/framework/diagram_builder.h"
+#include "drake/systems/primitives/constant_value_source.h"
+#include "pluginlib/class_list_macros.h"
+#include "ros/ros.h"
+#include "std_msgs/String.h"
+
+#include "../include/drake_ros_systems/drake_simulator_nodelet.h"
+#include "../include/drake_ros_systems/ros_publisher_system.h"
+#include "../include/drake_ros_systems/ros_subscriber_system.h"
+
+using drake::systems::AbstractValue;
+using drake::systems::ConstantValueSource;
+using drake::systems::DiagramBuilder;
+
+namespace drake_ros_systems {
+
+// Publishes on "test_nodelet_publish" and listens on "test_nodelet_subscribe"
+// from inside a nodelet manager, e.g.
+//   rosrun nodelet nodelet manager __name:=manager
+//   rosrun nodelet nodelet load drake_ros_systems/TestDrakeSimulatorNodelet
+//       manager
+class TestDrakeSimulatorNodelet : public DrakeSimulatorNodelet {
+ private:
+  void BuildDiagram(DiagramBuilder<double>* builder,
+                    ros::NodeHandle* node_handle) override {
+    auto msg_publisher =
+        builder->AddSystem(RosPublisherSystem<std_msgs::String>::Make(
+            "test_nodelet_publish", node_handle));
+    msg_publisher->set_publish_period(0.25);
+
+    std_msgs::String msg;
+    msg.data = "Hello from a nodelet!";
+
+    auto msg_source =
+        builder->AddSystem(std::make_unique<ConstantValueSource<double>>(
+            AbstractValue::Make<std_msgs::String>(msg)));
+    builder->Connect(msg_source->get_output_port(0),
+                     msg_publisher->get_input_port(0));
+
+    builder->AddSystem(RosSubscriberSystem<std_msgs::String>::Make(
+        "test_nodelet_subscribe", node_handle));
+  }
+};
+
+}  // namespace drake_ros_systems
+
+PLUGINLIB_EXPORT_CLASS(drake_ros_systems::TestDrakeSimulatorNodelet,
+                       nodelet::Nodelet)
@@ -0,0 +1,85 @@
+#include <memory>
+#include "drake/systems/analysis/simulator.h"
+#include "drake/systems/framework/diagram.h"
+#include "drake/systems/framework/diagram_builder.h"
+#include "drake/systems/primitives/constant_value_source.h"
+#include "ros/ros.h"
+#include "std_msgs/String.h"
+
+#include "../include/drake_ros_systems/network_impairment.h"
+#include "../include/drake_ros_systems/ros_publisher_system.h"
+#include "../include/drake_ros_systems/ros_subscriber_system.h"
+
+using drake::systems::AbstractValue;
+using drake::systems::ConstantValueSource;
+using drake::systems::DiagramBuilder;
+using drake::systems::Simulator;
+
+using namespace drake_ros_systems;
+
+// Publishes "test_impairment" at 50 Hz over a link with a jittery 50 ms
+// delay, 10% loss and occasional reordering, and receives it over a link
+// that only adds delay. The same seeds drop and reorder the same messages in
+// every run.
+int DoMain(ros::NodeHandle& node_handle) {
+  DiagramBuilder<double> builder;
+
+  auto msg_publisher =
+      builder.AddSystem(RosPublisherSystem<std_msgs::String>::Make(
+          "test_impairment", &node_handle));
+  msg_publisher->set_publish_period(0.02);
+
+  NetworkImpairmentConfig uplink;
+  uplink.delay = 0.05;
+  uplink.jitter = 0.01;
+  uplink.distribution = NetworkImpairmentConfig::DelayDistribution::kNormal;
+  uplink.loss_probability = 0.1;
+  uplink.reorder_probability = 0.05;
+  uplink.reorder_delay = 0.1;
+  uplink.seed = 1;
+  msg_publisher->set_network_impairment(uplink);
+
+  std_msgs::String msg;
+  msg.data = "Hello world";
+
+  auto msg_source =
+      builder.AddSystem(std::make_unique<ConstantValueSource<double>>(
+          AbstractValue::Make<std_msgs::String>(msg)));
+  builder.Connect(msg_source->get_output_port(0),
+                  msg_publisher->get_input_port(0));
+
+  auto msg_subscriber =
+      builder.AddSystem(RosSubscriberSystem<std_msgs::String>::Make(
+          "test_impairment", &node_handle));
+
+  NetworkImpairmentConfig downlink;
+  downlink.delay = 0.02;
+  downlink.seed = 2;
+  msg_subscriber->set_network_impairment(downlink);
+
+  auto sys = builder.Build();
+  Simulator<double> simulator(*sys);
+
+  ros::AsyncSpinner spinner(1);
+  spinner.start();
+
+  simulator.Initialize();
+  simulator.set_target_realtime_rate(1.0);
+  simulator.StepTo(10.0);
+
+  const NetworkImpairment<std_msgs::String>& link =
+      *msg_publisher->get_network_impairment();
+  ROS_INFO("Sent %d, dropped %d, reordered %d, received %d",
+           link.get_sent_count(), link.get_dropped_count(),
+           link.get_reordered_count(),
+           msg_subscriber->GetReceivedMessageCount());
+
+  return 0;
+}
+
+int main(int argc, char* argv[]) {
+  ros::init(argc, argv, "test_network_impairment");
+  ros::NodeHandle node_handle;
+
+  return DoMain(node_handle);
+}
@@ -0,0 +1,73 @@
+#include <memory>
+#include <thread>
+#include "drake/systems/analysis/simulator.h"
+#include "drake/systems/framework/diagram.h"
+#include "drake/systems/framework/diagram_builder.h"
+#include "drake/systems/primitives/constant_value_source.h"
+#include "rclcpp/rclcpp.hpp"
+#include "std_msgs/msg/string.hpp"
+
+#include "../include/drake_ros_systems/ros2_publisher_system.h"
+#include "../include/drake_ros_systems/ros2_subscriber_system.h"
+
+using drake::systems::AbstractValue;
+using drake::systems::ConstantValueSource;
+using drake::systems::DiagramBuilder;
+using drake::systems::Simulator;
+
+using namespace drake_ros_systems;
+
+// Loops a message from a Ros2PublisherSystem back into a
+// Ros2SubscriberSystem through intra-process communication on localhost, and
+// fails unless it arrives.
+int DoMain(rclcpp::Node* node) {
+  DiagramBuilder<double> builder;
+
+  auto msg_publisher = builder.AddSystem(
+      Ros2PublisherSystem<std_msgs::msg::String>::Make("test_ros2", node));
+  msg_publisher->set_publish_period(0.25);
+
+  std_msgs::msg::String msg;
+  msg.data = "Hello world!";
+
+  auto msg_source =
+      builder.AddSystem(std::make_unique<ConstantValueSource<double>>(
+          AbstractValue::Make<std_msgs::msg::String>(msg)));
+  builder.Connect(msg_source->get_output_port(0),
+                  msg_publisher->get_input_port(0));
+
+  auto msg_subscriber = builder.AddSystem(
+      Ros2SubscriberSystem<std_msgs::msg::String>::Make("test_ros2", node));
+
+  auto sys = builder.Build();
+  Simulator<double> simulator(*sys);
+
+  simulator.Initialize();
+  simulator.set_target_realtime_rate(1.0);
+  simulator.StepTo(2.0);
+
+  const auto& context =
+      sys->GetSubsystemContext(*msg_subscriber, simulator.get_context());
+  if (msg_subscriber->GetMessageCount(context) == 0) return 1;
+  const auto& received =
+      context.get_abstract_state<std_msgs::msg::String>(0);
+  return received.data == msg.data ? 0 : 1;
+}
+
+int main(int argc, char* argv[]) {
+  rclcpp::init(argc, argv);
+  auto node = std::make_shared<rclcpp::Node>(
+      "test_ros2_bridge_systems",
+      rclcpp::NodeOptions().use_intra_process_comms(true));
+
+  rclcpp::executors::SingleThreadedExecutor executor;
+  executor.add_node(node);
+  std::thread spinner([&executor]() { executor.spin(); });
+
+  const int result = DoMain(node.get());
+
+  executor.cancel();
+  spinner.join();
+  rclcpp::shutdown();
+  return result;
+}
@@ -0,0 +1,60 @@
+#include <memory>
+#include "drake/perception/point_cloud.h"
+#include "drake/systems/analysis/simulator.h"
+#include "drake/systems/framework/diagram.h"
+#include "drake/systems/framework/diagram_builder.h"
+#include "drake/systems/primitives/constant_value_source.h"
+#include "ros/ros.h"
+
+#include "../include/drake_ros_systems/ros_compact_point_cloud_publisher_system.h"
+#include "../include/drake_ros_systems/ros_compact_point_cloud_subscriber_system.h"
+
+using drake::perception::PointCloud;
+using drake::systems::AbstractValue;
+using drake::systems::ConstantValueSource;
+using drake::systems::DiagramBuilder;
+using drake::systems::Simulator;
+
+using namespace drake_ros_systems;
+
+// Publishes a random 2 m cube of points, [-1, 1] m on every axis, at 1 mm
+// resolution on "test_compact_cloud" and decodes it back.
+int DoMain(ros::NodeHandle& node_handle) {
+  DiagramBuilder<double> builder;
+
+  CompactPointCloudOptions options;
+  options.resolution = 0.001f;
+  auto cloud_publisher =
+      builder.AddSystem(std::make_unique<RosCompactPointCloudPublisherSystem>(
+          "test_compact_cloud", "world", &node_handle, options));
+  cloud_publisher->set_publish_period(0.1);
+
+  PointCloud cloud(10000);
+  cloud.mutable_xyzs().setRandom();
+  auto cloud_source =
+      builder.AddSystem(std::make_unique<ConstantValueSource<double>>(
+          AbstractValue::Make<PointCloud>(cloud)));
+  builder.Connect(cloud_source->get_output_port(0),
+                  cloud_publisher->get_input_port(0));
+
+  builder.AddSystem(std::make_unique<RosCompactPointCloudSubscriberSystem>(
+      "test_compact_cloud", &node_handle));
+
+  auto sys = builder.Build();
+  Simulator<double> simulator(*sys);
+
+  simulator.Initialize();
+  simulator.set_target_realtime_rate(1.0);
+  simulator.StepTo(std::numeric_limits<double>::infinity());
+
+  return 0;
+}
+
+int main(int argc, char* argv[]) {
+  ros::init(argc, argv, "test_ros_compact_point_cloud_systems");
+  ros::NodeHandle node_handle;
+  ros::AsyncSpinner spinner(1);
+  spinner.start();
+
+  return DoMain(node_handle);
+}
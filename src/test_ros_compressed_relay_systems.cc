@@ -0,0 +1,75 @@
+#include <memory>
+#include "drake/systems/analysis/simulator.h"
+#include "drake/systems/framework/diagram.h"
+#include "drake/systems/framework/diagram_builder.h"
+#include "drake/systems/primitives/constant_value_source.h"
+#include "nav_msgs/OccupancyGrid.h"
+#include "ros/ros.h"
+
+#include "../include/drake_ros_systems/ros_compressed_publisher_system.h"
+#include "../include/drake_ros_systems/ros_compressed_subscriber_system.h"
+
+using drake::systems::AbstractValue;
+using drake::systems::ConstantValueSource;
+using drake::systems::DiagramBuilder;
+using drake::systems::Simulator;
+
+using namespace drake_ros_systems;
+
+// Relays a mostly free 2000 x 2000 occupancy grid at 10 Hz over
+// "test_compressed_grid" with zstd and decodes it back. Throttling the topic,
+// e.g. with a network impairment or tc, makes the level go up.
+int DoMain(ros::NodeHandle& node_handle) {
+  DiagramBuilder<double> builder;
+
+  CompressedRelayOptions options;
+  options.codec = CompressedMessage::CODEC_ZSTD;
+  auto grid_publisher = builder.AddSystem(
+      std::make_unique<RosCompressedPublisherSystem<nav_msgs::OccupancyGrid>>(
+          "test_compressed_grid", &node_handle, options));
+  grid_publisher->set_publish_period(0.1);
+
+  nav_msgs::OccupancyGrid grid;
+  grid.header.frame_id = "world";
+  grid.info.resolution = 0.05;
+  grid.info.width = 2000;
+  grid.info.height = 2000;
+  grid.data.assign(grid.info.width * grid.info.height, 0);
+  for (uint32_t i = 0; i < grid.info.width; ++i) {
+    grid.data[i] = 100;
+    grid.data[grid.data.size() - 1 - i] = 100;
+  }
+  auto grid_source =
+      builder.AddSystem(std::make_unique<ConstantValueSource<double>>(
+          AbstractValue::Make<nav_msgs::OccupancyGrid>(grid)));
+  builder.Connect(grid_source->get_output_port(0),
+                  grid_publisher->get_input_port(0));
+
+  builder.AddSystem(
+      std::make_unique<RosCompressedSubscriberSystem<nav_msgs::OccupancyGrid>>(
+          "test_compressed_grid", &node_handle));
+
+  auto sys = builder.Build();
+  Simulator<double> simulator(*sys);
+
+  simulator.Initialize();
+  simulator.set_target_realtime_rate(1.0);
+  while (ros::ok()) {
+    simulator.StepTo(simulator.get_context().get_time() + 1.0);
+    ROS_INFO("level %d at %.0f bytes/s, %d dropped",
+             grid_publisher->get_compression_level(),
+             grid_publisher->get_link_bandwidth(),
+             grid_publisher->get_dropped_message_count());
+  }
+
+  return 0;
+}
+
+int main(int argc, char* argv[]) {
+  ros::init(argc, argv, "test_ros_compressed_relay_systems");
+  ros::NodeHandle node_handle;
+  ros::AsyncSpinner spinner(1);
+  spinner.start();
+
+  return DoMain(node_handle);
+}
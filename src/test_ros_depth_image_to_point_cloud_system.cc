@@ -0,0 +1,51 @@
+#include <memory>
+#include "drake/systems/analysis/simulator.h"
+#include "drake/systems/framework/diagram.h"
+#include "drake/systems/framework/diagram_builder.h"
+#include "ros/ros.h"
+
+#include "../include/drake_ros_systems/ros_depth_image_to_point_cloud_system.h"
+
+using drake::systems::DiagramBuilder;
+using drake::systems::Simulator;
+
+using namespace drake_ros_systems;
+
+// Converts "camera/depth/image_raw" into a point cloud, keeping every second
+// pixel of every second row.
+int DoMain(ros::NodeHandle& node_handle) {
+  DiagramBuilder<double> builder;
+
+  DepthImageToPointCloudOptions options;
+  options.stride = 2;
+  auto depth_to_cloud =
+      builder.AddSystem(std::make_unique<RosDepthImageToPointCloudSystem>(
+          "camera/depth/image_raw", "camera/depth/camera_info", &node_handle,
+          options));
+  builder.ExportOutput(depth_to_cloud->get_output_port(0));
+
+  auto sys = builder.Build();
+  Simulator<double> simulator(*sys);
+
+  simulator.Initialize();
+  simulator.set_target_realtime_rate(1.0);
+  auto output = sys->AllocateOutput(simulator.get_context());
+  while (ros::ok()) {
+    simulator.StepTo(simulator.get_context().get_time() + 1.0);
+    sys->CalcOutput(simulator.get_context(), output.get());
+    ROS_INFO("Point cloud with %d points",
+             output->get_data(0)->GetValue<drake::perception::PointCloud>()
+                 .size());
+  }
+
+  return 0;
+}
+
+int main(int argc, char* argv[]) {
+  ros::init(argc, argv, "test_ros_depth_image_to_point_cloud_system");
+  ros::NodeHandle node_handle;
+  ros::AsyncSpinner spinner(2);
+  spinner.start();
+
+  return DoMain(node_handle);
+}
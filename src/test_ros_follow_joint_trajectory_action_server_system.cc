@@ -0,0 +1,73 @@
+#include <memory>
+#include "drake/multibody/plant/multibody_plant.h"
+#include "drake/multibody/tree/revolute_joint.h"
+#include "drake/systems/analysis/simulator.h"
+#include "drake/systems/controllers/pid_controller.h"
+#include "drake/systems/framework/diagram.h"
+#include "drake/systems/framework/diagram_builder.h"
+#include "ros/ros.h"
+
+#include "../include/drake_ros_systems/ros_follow_joint_trajectory_action_server_system.h"
+
+using drake::multibody::MultibodyPlant;
+using drake::multibody::RevoluteJoint;
+using drake::multibody::SpatialInertia;
+using drake::multibody::UnitInertia;
+using drake::systems::DiagramBuilder;
+using drake::systems::Simulator;
+using drake::systems::controllers::PidController;
+
+using namespace drake_ros_systems;
+
+// Serves `pendulum_controller/follow_joint_trajectory` for an actuated 1 m
+// pendulum whose joint is called "pin", tracked by a PID controller. Goals
+// can be sent e.g. with rqt_joint_trajectory_controller or MoveIt.
+int DoMain(ros::NodeHandle& node_handle) {
+  DiagramBuilder<double> builder;
+
+  auto plant = builder.AddSystem(std::make_unique<MultibodyPlant<double>>());
+  const Eigen::Vector3d p_BoBcm(0.0, 0.0, -1.0);
+  const auto& arm = plant->AddRigidBody(
+      "arm", SpatialInertia<double>(1.0, p_BoBcm,
+                                    UnitInertia<double>::PointMass(p_BoBcm)));
+  const auto& pin = plant->AddJoint<RevoluteJoint>(
+      "pin", plant->world_body(), {}, arm, {}, Eigen::Vector3d::UnitY());
+  plant->AddJointActuator("pin_motor", pin);
+  plant->Finalize();
+
+  auto server = builder.AddSystem(
+      std::make_unique<RosFollowJointTrajectoryActionServerSystem>(
+          "pendulum_controller/follow_joint_trajectory",
+          std::vector<std::string>{"pin"}, &node_handle));
+  auto controller = builder.AddSystem(std::make_unique<PidController<double>>(
+      Eigen::VectorXd::Constant(1, 100.0), Eigen::VectorXd::Constant(1, 1.0),
+      Eigen::VectorXd::Constant(1, 20.0)));
+
+  builder.Connect(plant->get_state_output_port(), server->get_input_port(0));
+  builder.Connect(plant->get_state_output_port(),
+                  controller->get_input_port_estimated_state());
+  builder.Connect(server->get_output_port(0),
+                  controller->get_input_port_desired_state());
+  builder.Connect(controller->get_output_port_control(),
+                  plant->get_actuation_input_port());
+
+  auto sys = builder.Build();
+  Simulator<double> simulator(*sys);
+
+  simulator.set_target_realtime_rate(1.0);
+  simulator.Initialize();
+  // Goals are served by the system's own spinner.
+  while (ros::ok()) {
+    simulator.StepTo(simulator.get_context().get_time() + 0.1);
+  }
+
+  return 0;
+}
+
+int main(int argc, char* argv[]) {
+  ros::init(argc, argv,
+            "test_ros_follow_joint_trajectory_action_server_system");
+  ros::NodeHandle node_handle;
+
+  return DoMain(node_handle);
+}
@@ -0,0 +1,40 @@
+#include <memory>
+#include "drake/systems/analysis/simulator.h"
+#include "drake/systems/framework/diagram.h"
+#include "drake/systems/framework/diagram_builder.h"
+#include "ros/ros.h"
+
+#include "../include/drake_ros_systems/ros_image_subscriber_system.h"
+
+using drake::systems::DiagramBuilder;
+using drake::systems::Simulator;
+
+using namespace drake_ros_systems;
+
+// Receives "camera/image_raw", rectified with "camera/camera_info".
+int DoMain(ros::NodeHandle& node_handle) {
+  DiagramBuilder<double> builder;
+
+  auto image_subscriber =
+      builder.AddSystem(std::make_unique<RosImageSubscriberSystem>(
+          "camera/image_raw", &node_handle));
+  image_subscriber->EnableRectification("camera/camera_info");
+
+  auto sys = builder.Build();
+  Simulator<double> simulator(*sys);
+
+  simulator.Initialize();
+  simulator.set_target_realtime_rate(1.0);
+  simulator.StepTo(std::numeric_limits<double>::infinity());
+
+  return 0;
+}
+
+int main(int argc, char* argv[]) {
+  ros::init(argc, argv, "test_ros_image_subscriber_system");
+  ros::NodeHandle node_handle;
+  ros::AsyncSpinner spinner(2);
+  spinner.start();
+
+  return DoMain(node_handle);
+}
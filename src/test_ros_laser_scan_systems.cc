@@ -0,0 +1,62 @@
+#include <memory>
+#include "drake/systems/analysis/simulator.h"
+#include "drake/systems/framework/diagram.h"
+#include "drake/systems/framework/diagram_builder.h"
+#include "drake/systems/primitives/constant_vector_source.h"
+#include "ros/ros.h"
+
+#include "../include/drake_ros_systems/ros_laser_scan_publisher_system.h"
+#include "../include/drake_ros_systems/ros_laser_scan_subscriber_system.h"
+
+using drake::systems::ConstantVectorSource;
+using drake::systems::DiagramBuilder;
+using drake::systems::Simulator;
+
+using namespace drake_ros_systems;
+
+// Publishes a constant 2 m circular scan on "test_scan" and converts it back
+// into a point cloud.
+int DoMain(ros::NodeHandle& node_handle) {
+  DiagramBuilder<double> builder;
+
+  LaserScanSpecification spec;
+  spec.frame_id = "laser";
+  spec.num_beams = 360;
+  spec.angle_min = -M_PI;
+  spec.angle_max = M_PI * 359. / 360.;
+  spec.range_min = 0.1;
+  spec.range_max = 10.0;
+  spec.scan_time = 0.1;
+
+  auto scan_publisher =
+      builder.AddSystem(std::make_unique<RosLaserScanPublisherSystem>(
+          "test_scan", spec, &node_handle));
+  scan_publisher->set_publish_period(spec.scan_time);
+
+  auto ranges_source = builder.AddSystem(
+      std::make_unique<ConstantVectorSource<double>>(
+          Eigen::VectorXd::Constant(spec.num_beams, 2.0)));
+  builder.Connect(ranges_source->get_output_port(),
+                  scan_publisher->get_input_port(0));
+
+  builder.AddSystem(std::make_unique<RosLaserScanSubscriberSystem>(
+      "test_scan", &node_handle));
+
+  auto sys = builder.Build();
+  Simulator<double> simulator(*sys);
+
+  simulator.Initialize();
+  simulator.set_target_realtime_rate(1.0);
+  simulator.StepTo(std::numeric_limits<double>::infinity());
+
+  return 0;
+}
+
+int main(int argc, char* argv[]) {
+  ros::init(argc, argv, "test_ros_laser_scan_systems");
+  ros::NodeHandle node_handle;
+  ros::AsyncSpinner spinner(1);
+  spinner.start();
+
+  return DoMain(node_handle);
+}
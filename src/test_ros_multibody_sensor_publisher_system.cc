@@ -0,0 +1,69 @@
+#include <memory>
+#include "drake/multibody/plant/multibody_plant.h"
+#include "drake/multibody/tree/revolute_joint.h"
+#include "drake/systems/analysis/simulator.h"
+#include "drake/systems/framework/diagram.h"
+#include "drake/systems/framework/diagram_builder.h"
+#include "ros/ros.h"
+
+#include "../include/drake_ros_systems/ros_multibody_sensor_publisher_system.h"
+
+using drake::multibody::MultibodyPlant;
+using drake::multibody::RevoluteJoint;
+using drake::multibody::SpatialInertia;
+using drake::multibody::UnitInertia;
+using drake::systems::DiagramBuilder;
+using drake::systems::Simulator;
+
+using namespace drake_ros_systems;
+
+// Simulates a 1 m pendulum and publishes an IMU at its bob, its odometry and
+// the pin reaction wrench on "test_imu", "test_odom" and "test_wrench".
+int DoMain(ros::NodeHandle& node_handle) {
+  DiagramBuilder<double> builder;
+
+  auto plant = builder.AddSystem(std::make_unique<MultibodyPlant<double>>());
+  const Eigen::Vector3d p_BoBcm(0.0, 0.0, -1.0);
+  const auto& arm = plant->AddRigidBody(
+      "arm", SpatialInertia<double>(1.0, p_BoBcm,
+                                    UnitInertia<double>::PointMass(p_BoBcm)));
+  const auto& pin = plant->AddJoint<RevoluteJoint>(
+      "pin", plant->world_body(), {}, arm, {}, Eigen::Vector3d::UnitY());
+  plant->Finalize();
+
+  auto sensors =
+      builder.AddSystem(std::make_unique<RosMultibodySensorPublisherSystem>(
+          *plant, &node_handle, 0.01));
+  Eigen::Isometry3d X_BS = Eigen::Isometry3d::Identity();
+  X_BS.translation() = p_BoBcm;
+  sensors->AddImu("test_imu", arm, "imu", X_BS);
+  sensors->AddOdometry("test_odom", arm, "world", "arm");
+  sensors->AddWrench("test_wrench", pin, "arm");
+
+  builder.Connect(plant->get_state_output_port(),
+                  sensors->get_state_input_port());
+  builder.Connect(plant->get_generalized_acceleration_output_port(),
+                  sensors->get_generalized_acceleration_input_port());
+  builder.Connect(plant->get_reaction_forces_output_port(),
+                  sensors->get_reaction_forces_input_port());
+
+  auto sys = builder.Build();
+  Simulator<double> simulator(*sys);
+
+  auto& plant_context =
+      sys->GetMutableSubsystemContext(*plant, &simulator.get_mutable_context());
+  pin.set_angle(&plant_context, 1.0);
+
+  simulator.Initialize();
+  simulator.set_target_realtime_rate(1.0);
+  simulator.StepTo(std::numeric_limits<double>::infinity());
+
+  return 0;
+}
+
+int main(int argc, char* argv[]) {
+  ros::init(argc, argv, "test_ros_multibody_sensor_publisher_system");
+  ros::NodeHandle node_handle;
+
+  return DoMain(node_handle);
+}
@@ -0,0 +1,64 @@
+#include <memory>
+#include "drake/systems/analysis/simulator.h"
+#include "drake/systems/framework/diagram.h"
+#include "drake/systems/framework/diagram_builder.h"
+#include "drake/systems/primitives/constant_value_source.h"
+#include "nav_msgs/OccupancyGrid.h"
+#include "ros/ros.h"
+
+#include "../include/drake_ros_systems/ros_occupancy_grid_publisher_system.h"
+#include "../include/drake_ros_systems/ros_occupancy_grid_subscriber_system.h"
+
+using drake::systems::AbstractValue;
+using drake::systems::ConstantValueSource;
+using drake::systems::DiagramBuilder;
+using drake::systems::Simulator;
+
+using namespace drake_ros_systems;
+
+// Publishes a static 1000x1000 grid on "test_grid"; after the first keyframe
+// nothing is dirty, so only the periodic keyframes go out. The subscriber
+// reassembles it.
+int DoMain(ros::NodeHandle& node_handle) {
+  DiagramBuilder<double> builder;
+
+  auto grid_publisher =
+      builder.AddSystem(std::make_unique<RosOccupancyGridPublisherSystem>(
+          "test_grid", &node_handle));
+  grid_publisher->set_publish_period(0.1);
+
+  nav_msgs::OccupancyGrid grid;
+  grid.header.frame_id = "map";
+  grid.info.resolution = 0.05;
+  grid.info.width = 1000;
+  grid.info.height = 1000;
+  grid.info.origin.orientation.w = 1.0;
+  grid.data.assign(grid.info.width * grid.info.height, 0);
+
+  auto grid_source =
+      builder.AddSystem(std::make_unique<ConstantValueSource<double>>(
+          AbstractValue::Make<nav_msgs::OccupancyGrid>(grid)));
+  builder.Connect(grid_source->get_output_port(0),
+                  grid_publisher->get_input_port(0));
+
+  builder.AddSystem(std::make_unique<RosOccupancyGridSubscriberSystem>(
+      "test_grid", &node_handle));
+
+  auto sys = builder.Build();
+  Simulator<double> simulator(*sys);
+
+  simulator.Initialize();
+  simulator.set_target_realtime_rate(1.0);
+  simulator.StepTo(std::numeric_limits<double>::infinity());
+
+  return 0;
+}
+
+int main(int argc, char* argv[]) {
+  ros::init(argc, argv, "test_ros_occupancy_grid_systems");
+  ros::NodeHandle node_handle;
+  ros::AsyncSpinner spinner(1);
+  spinner.start();
+
+  return DoMain(node_handle);
+}
@@ -0,0 +1,74 @@
+#include <memory>
+#include "drake/geometry/scene_graph.h"
+#include "drake/math/rigid_transform.h"
+#include "drake/multibody/plant/multibody_plant.h"
+#include "drake/multibody/tree/revolute_joint.h"
+#include "drake/systems/analysis/simulator.h"
+#include "drake/systems/framework/diagram.h"
+#include "drake/systems/framework/diagram_builder.h"
+#include "ros/ros.h"
+
+#include "../include/drake_ros_systems/ros_planning_scene_publisher_system.h"
+
+using drake::geometry::Box;
+using drake::geometry::Sphere;
+using drake::math::RigidTransformd;
+using drake::multibody::AddMultibodyPlantSceneGraph;
+using drake::multibody::CoulombFriction;
+using drake::multibody::RevoluteJoint;
+using drake::multibody::SpatialInertia;
+using drake::multibody::UnitInertia;
+using drake::systems::DiagramBuilder;
+using drake::systems::Simulator;
+
+using namespace drake_ros_systems;
+
+// Simulates a 1 m pendulum swinging over a fixed table and mirrors both into
+// MoveIt's planning scene through diffs on "planning_scene".
+int DoMain(ros::NodeHandle& node_handle) {
+  DiagramBuilder<double> builder;
+
+  auto plant_and_scene_graph = AddMultibodyPlantSceneGraph(&builder, 0.0);
+  auto& plant = plant_and_scene_graph.plant;
+  auto& scene_graph = plant_and_scene_graph.scene_graph;
+  const CoulombFriction<double> friction(0.5, 0.5);
+
+  plant.RegisterCollisionGeometry(plant.world_body(),
+                                  RigidTransformd(Eigen::Vector3d(0, 0, -2)),
+                                  Box(1.0, 1.0, 0.1), "table", friction);
+  const Eigen::Vector3d p_BoBcm(0.0, 0.0, -1.0);
+  const auto& arm = plant.AddRigidBody(
+      "arm", SpatialInertia<double>(1.0, p_BoBcm,
+                                    UnitInertia<double>::PointMass(p_BoBcm)));
+  plant.RegisterCollisionGeometry(arm, RigidTransformd(p_BoBcm), Sphere(0.1),
+                                  "bob", friction);
+  const auto& pin = plant.AddJoint<RevoluteJoint>(
+      "pin", plant.world_body(), {}, arm, {}, Eigen::Vector3d::UnitY());
+  plant.Finalize();
+
+  auto scene_publisher =
+      builder.AddSystem(std::make_unique<RosPlanningSceneDiffPublisherSystem>(
+          "planning_scene", &node_handle, 0.05));
+  builder.Connect(scene_graph.get_query_output_port(),
+                  scene_publisher->get_input_port(0));
+
+  auto sys = builder.Build();
+  Simulator<double> simulator(*sys);
+
+  auto& plant_context =
+      sys->GetMutableSubsystemContext(plant, &simulator.get_mutable_context());
+  pin.set_angle(&plant_context, 1.0);
+
+  simulator.Initialize();
+  simulator.set_target_realtime_rate(1.0);
+  simulator.StepTo(std::numeric_limits<double>::infinity());
+
+  return 0;
+}
+
+int main(int argc, char* argv[]) {
+  ros::init(argc, argv, "test_ros_planning_scene_publisher_system");
+  ros::NodeHandle node_handle;
+
+  return DoMain(node_handle);
+}
@@ -14,7 +14,7 @@ using drake::systems::ConstantValueSource;
 using drake::systems::Context;
 using drake::systems::Diagram;
 using drake::systems::DiagramBuilder;
-using drake::systems::InputPortDescriptor;
+using drake::systems::InputPort;
 using drake::systems::OutputPort;
 using drake::systems::Simulator;
 
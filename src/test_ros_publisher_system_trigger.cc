@@ -0,0 +1,61 @@
+#include <memory>
+#include "drake/systems/analysis/simulator.h"
+#include "drake/systems/framework/diagram.h"
+#include "drake/systems/framework/diagram_builder.h"
+#include "drake/systems/primitives/constant_value_source.h"
+#include "drake/systems/primitives/sine.h"
+#include "ros/ros.h"
+#include "std_msgs/String.h"
+
+#include "../include/drake_ros_systems/ros_publisher_system.h"
+
+using drake::systems::AbstractValue;
+using drake::systems::ConstantValueSource;
+using drake::systems::DiagramBuilder;
+using drake::systems::Simulator;
+using drake::systems::Sine;
+using drake::systems::WitnessFunctionDirection;
+
+using namespace drake_ros_systems;
+
+// Publishes on "test_publish_trigger" exactly when a 0.5 Hz sine rises
+// through zero, i.e. at t = 2, 4, 6, ... s, instead of periodically. The sine
+// starts at zero without having been negative, so t = 0 is not a crossing.
+int DoMain(ros::NodeHandle& node_handle) {
+  DiagramBuilder<double> builder;
+
+  auto msg_publisher =
+      builder.AddSystem(RosPublisherSystem<std_msgs::String>::Make(
+          "test_publish_trigger", &node_handle));
+  const auto& trigger_port = msg_publisher->DeclarePublishTrigger(
+      WitnessFunctionDirection::kNegativeThenNonNegative);
+
+  std_msgs::String msg;
+  msg.data = "Rising edge!";
+
+  auto msg_source =
+      builder.AddSystem(std::make_unique<ConstantValueSource<double>>(
+          AbstractValue::Make<std_msgs::String>(msg)));
+  builder.Connect(msg_source->get_output_port(0),
+                  msg_publisher->get_input_port(0));
+
+  auto trigger_source = builder.AddSystem(
+      std::make_unique<Sine<double>>(1.0, M_PI, 0.0, 1));
+  builder.Connect(trigger_source->get_output_port(0), trigger_port);
+
+  auto sys = builder.Build();
+  Simulator<double> simulator(*sys);
+
+  simulator.Initialize();
+  simulator.set_target_realtime_rate(1.0);
+  simulator.StepTo(std::numeric_limits<double>::infinity());
+
+  return 0;
+}
+
+int main(int argc, char* argv[]) {
+  ros::init(argc, argv, "test_ros_publisher_system_trigger");
+  ros::NodeHandle node_handle;
+
+  return DoMain(node_handle);
+}
@@ -0,0 +1,49 @@
+#include <memory>
+#include "drake/systems/analysis/simulator.h"
+#include "drake/systems/framework/diagram.h"
+#include "drake/systems/framework/diagram_builder.h"
+#include "drake/systems/primitives/sine.h"
+#include "ros/ros.h"
+
+#include "../include/drake_ros_systems/ros_signal_scope_publisher_system.h"
+
+using drake::systems::DiagramBuilder;
+using drake::systems::Simulator;
+using drake::systems::Sine;
+
+using namespace drake_ros_systems;
+
+// Streams 100 sine channels, sampled every millisecond, as one message per
+// 50 ms window on "test_signal_scope".
+int DoMain(ros::NodeHandle& node_handle) {
+  const int kNumChannels = 100;
+  DiagramBuilder<double> builder;
+
+  auto scope =
+      builder.AddSystem(std::make_unique<RosSignalScopePublisherSystem>(
+          "test_signal_scope", &node_handle, 0.05));
+
+  auto sines = builder.AddSystem(std::make_unique<Sine<double>>(
+      Eigen::VectorXd::Ones(kNumChannels),
+      Eigen::VectorXd::LinSpaced(kNumChannels, 1.0, 10.0),
+      Eigen::VectorXd::Zero(kNumChannels)));
+  builder.Connect(sines->get_output_port(0),
+                  scope->AddInput("sine", kNumChannels));
+
+  auto sys = builder.Build();
+  Simulator<double> simulator(*sys);
+
+  simulator.get_mutable_integrator()->set_maximum_step_size(0.001);
+  simulator.Initialize();
+  simulator.set_target_realtime_rate(1.0);
+  simulator.StepTo(std::numeric_limits<double>::infinity());
+
+  return 0;
+}
+
+int main(int argc, char* argv[]) {
+  ros::init(argc, argv, "test_ros_signal_scope_publisher_system");
+  ros::NodeHandle node_handle;
+
+  return DoMain(node_handle);
+}
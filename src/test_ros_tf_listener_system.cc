@@ -0,0 +1,46 @@
+#include <memory>
+#include "drake/systems/analysis/simulator.h"
+#include "drake/systems/framework/diagram.h"
+#include "drake/systems/framework/diagram_builder.h"
+#include "ros/ros.h"
+
+#include "../include/drake_ros_systems/ros_tf_listener_system.h"
+
+using drake::systems::DiagramBuilder;
+using drake::systems::Simulator;
+
+using namespace drake_ros_systems;
+
+// Tracks the pose of "base_link" in "world", e.g. as published by
+//   rosrun tf2_ros static_transform_publisher 1 0 0 0 0 0 world base_link
+int DoMain(ros::NodeHandle& node_handle) {
+  DiagramBuilder<double> builder;
+
+  auto tf_listener =
+      builder.AddSystem(std::make_unique<RosTfListenerSystem>(&node_handle));
+  const auto& X_WB_port = tf_listener->AddFramePair("world", "base_link");
+  builder.ExportOutput(X_WB_port);
+
+  auto sys = builder.Build();
+  Simulator<double> simulator(*sys);
+
+  simulator.Initialize();
+  simulator.set_target_realtime_rate(1.0);
+  auto output = sys->AllocateOutput(simulator.get_context());
+  while (ros::ok()) {
+    simulator.StepTo(simulator.get_context().get_time() + 1.0);
+    sys->CalcOutput(simulator.get_context(), output.get());
+    const Eigen::Isometry3d& X_WB =
+        output->get_data(0)->GetValue<Eigen::Isometry3d>();
+    ROS_INFO_STREAM("X_WB translation: " << X_WB.translation().transpose());
+  }
+
+  return 0;
+}
+
+int main(int argc, char* argv[]) {
+  ros::init(argc, argv, "test_ros_tf_listener_system");
+  ros::NodeHandle node_handle;
+
+  return DoMain(node_handle);
+}
@@ -0,0 +1,64 @@
+#include <memory>
+#include "drake/multibody/plant/multibody_plant.h"
+#include "drake/multibody/tree/revolute_joint.h"
+#include "drake/systems/analysis/simulator.h"
+#include "drake/systems/framework/diagram.h"
+#include "drake/systems/framework/diagram_builder.h"
+#include "ros/ros.h"
+
+#include "../include/drake_ros_systems/ros_wrench_subscriber_system.h"
+
+using drake::multibody::MultibodyPlant;
+using drake::multibody::RevoluteJoint;
+using drake::multibody::SpatialInertia;
+using drake::multibody::UnitInertia;
+using drake::systems::DiagramBuilder;
+using drake::systems::Simulator;
+
+using namespace drake_ros_systems;
+
+// Simulates a 1 m pendulum pushed around by the wrenches on
+// "test_wrench_teleop" and "test_wrench_disturbance", e.g. with
+//   rostopic pub -r 10 /test_wrench_teleop geometry_msgs/WrenchStamped
+//     '{header: {frame_id: arm}, wrench: {force: {x: 5.0}}}'
+int DoMain(ros::NodeHandle& node_handle) {
+  DiagramBuilder<double> builder;
+
+  auto plant = builder.AddSystem(std::make_unique<MultibodyPlant<double>>());
+  const Eigen::Vector3d p_BoBcm(0.0, 0.0, -1.0);
+  const auto& arm = plant->AddRigidBody(
+      "arm", SpatialInertia<double>(1.0, p_BoBcm,
+                                    UnitInertia<double>::PointMass(p_BoBcm)));
+  plant->AddJoint<RevoluteJoint>("pin", plant->world_body(), {}, arm, {},
+                                 Eigen::Vector3d::UnitY());
+  plant->Finalize();
+
+  auto wrenches = builder.AddSystem(
+      std::make_unique<RosWrenchSubscriberSystem>(*plant, &node_handle));
+  wrenches->AddWrenchTopic("test_wrench_teleop");
+  wrenches->AddWrenchTopic("test_wrench_disturbance");
+
+  builder.Connect(plant->get_body_poses_output_port(),
+                  wrenches->get_body_poses_input_port());
+  builder.Connect(wrenches->get_output_port(0),
+                  plant->get_applied_spatial_force_input_port());
+
+  auto sys = builder.Build();
+  Simulator<double> simulator(*sys);
+
+  ros::AsyncSpinner spinner(1);
+  spinner.start();
+
+  simulator.Initialize();
+  simulator.set_target_realtime_rate(1.0);
+  simulator.StepTo(std::numeric_limits<double>::infinity());
+
+  return 0;
+}
+
+int main(int argc, char* argv[]) {
+  ros::init(argc, argv, "test_ros_wrench_subscriber_system");
+  ros::NodeHandle node_handle;
+
+  return DoMain(node_handle);
+}
@@ -0,0 +1,48 @@
+#include <memory>
+#include "drake/systems/analysis/simulator.h"
+#include "drake/systems/framework/diagram.h"
+#include "drake/systems/framework/diagram_builder.h"
+#include "ros/ros.h"
+#include "sensor_msgs/Imu.h"
+
+#include "../include/drake_ros_systems/ros_subscriber_system.h"
+
+using drake::systems::DiagramBuilder;
+using drake::systems::Simulator;
+
+using namespace drake_ros_systems;
+
+// Subscribes to "test_stale_imu", dropping messages stamped more than 50 ms
+// before the newest one, and reports the drop count every second.
+int DoMain(ros::NodeHandle& node_handle) {
+  DiagramBuilder<double> builder;
+
+  auto imu_subscriber =
+      builder.AddSystem(RosSubscriberSystem<sensor_msgs::Imu>::Make(
+          "test_stale_imu", &node_handle));
+  imu_subscriber->set_stale_message_horizon(0.05);
+
+  auto sys = builder.Build();
+  Simulator<double> simulator(*sys);
+
+  ros::AsyncSpinner spinner(1);
+  spinner.start();
+
+  simulator.Initialize();
+  simulator.set_target_realtime_rate(1.0);
+  while (ros::ok()) {
+    simulator.StepTo(simulator.get_context().get_time() + 1.0);
+    ROS_INFO("Received %d messages, dropped %d stale ones",
+             imu_subscriber->GetMessageCount(simulator.get_context()),
+             imu_subscriber->get_stale_message_count());
+  }
+
+  return 0;
+}
+
+int main(int argc, char* argv[]) {
+  ros::init(argc, argv, "test_stale_message_filter");
+  ros::NodeHandle node_handle;
+
+  return DoMain(node_handle);
+}
@@ -0,0 +1,69 @@
+#include <memory>
+#include "drake/systems/analysis/simulator.h"
+#include "drake/systems/framework/diagram.h"
+#include "drake/systems/framework/diagram_builder.h"
+#include "drake/systems/primitives/constant_value_source.h"
+#include "ros/ros.h"
+#include "std_msgs/String.h"
+
+#include "../include/drake_ros_systems/ros_publisher_system.h"
+#include "../include/drake_ros_systems/ros_subscriber_system.h"
+#include "../include/drake_ros_systems/startup_barrier.h"
+
+using drake::systems::AbstractValue;
+using drake::systems::ConstantValueSource;
+using drake::systems::DiagramBuilder;
+using drake::systems::Simulator;
+
+using namespace drake_ros_systems;
+
+// Waits up to 10 s for a message on "test_startup_in" and for a subscriber
+// on "test_startup_out" before starting the simulation.
+int DoMain(ros::NodeHandle& node_handle) {
+  DiagramBuilder<double> builder;
+
+  auto msg_subscriber =
+      builder.AddSystem(RosSubscriberSystem<std_msgs::String>::Make(
+          "test_startup_in", &node_handle));
+  auto msg_publisher =
+      builder.AddSystem(RosPublisherSystem<std_msgs::String>::Make(
+          "test_startup_out", &node_handle));
+  msg_publisher->set_publish_period(0.25);
+
+  std_msgs::String msg;
+  msg.data = "Hello world!";
+  auto msg_source =
+      builder.AddSystem(std::make_unique<ConstantValueSource<double>>(
+          AbstractValue::Make<std_msgs::String>(msg)));
+  builder.Connect(msg_source->get_output_port(0),
+                  msg_publisher->get_input_port(0));
+
+  auto sys = builder.Build();
+
+  ros::AsyncSpinner spinner(1);
+  spinner.start();
+
+  StartupBarrier barrier;
+  barrier.AddSubscriber(*msg_subscriber);
+  barrier.AddPublisher(*msg_publisher);
+  const StartupReport report = barrier.Wait(10.0);
+  ROS_INFO("%s", report.ToString().c_str());
+  if (!report.all_ready) return 1;
+
+  // Constructed after the barrier, so the subscriber starts from the first
+  // received message.
+  Simulator<double> simulator(*sys);
+
+  simulator.Initialize();
+  simulator.set_target_realtime_rate(1.0);
+  simulator.StepTo(std::numeric_limits<double>::infinity());
+
+  return 0;
+}
+
+int main(int argc, char* argv[]) {
+  ros::init(argc, argv, "test_startup_barrier");
+  ros::NodeHandle node_handle;
+
+  return DoMain(node_handle);
+}
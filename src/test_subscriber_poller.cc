@@ -0,0 +1,67 @@
+#include <memory>
+#include "drake/systems/framework/context.h"
+#include "drake/systems/framework/diagram.h"
+#include "drake/systems/framework/diagram_builder.h"
+#include "ros/ros.h"
+#include "std_msgs/Float64.h"
+#include "std_msgs/String.h"
+
+#include "../include/drake_ros_systems/ros_subscriber_system.h"
+#include "../include/drake_ros_systems/subscriber_poller.h"
+
+using drake::systems::Context;
+using drake::systems::DiagramBuilder;
+
+using namespace drake_ros_systems;
+
+// Runs a 2 kHz loop without a Simulator, reporting every value received on
+// "test_poll_float" and "test_poll_string".
+int DoMain(ros::NodeHandle& node_handle) {
+  DiagramBuilder<double> builder;
+
+  auto float_subscriber =
+      builder.AddSystem(RosSubscriberSystem<std_msgs::Float64>::Make(
+          "test_poll_float", &node_handle));
+  auto string_subscriber =
+      builder.AddSystem(RosSubscriberSystem<std_msgs::String>::Make(
+          "test_poll_string", &node_handle));
+
+  auto sys = builder.Build();
+  std::unique_ptr<Context<double>> context = sys->CreateDefaultContext();
+
+  SubscriberPoller poller(*sys, context.get());
+  const int float_index = poller.AddSubscriber(*float_subscriber);
+  const int string_index = poller.AddSubscriber(*string_subscriber);
+
+  ros::AsyncSpinner spinner(1);
+  spinner.start();
+
+  ros::Rate rate(2000);
+  while (ros::ok()) {
+    if (poller.Poll() > 0) {
+      const Context<double>& float_context =
+          sys->GetSubsystemContext(*float_subscriber, *context);
+      const Context<double>& string_context =
+          sys->GetSubsystemContext(*string_subscriber, *context);
+      if (poller.has_changed(float_index)) {
+        ROS_INFO("float: %f",
+                 float_context.get_abstract_state<std_msgs::Float64>(0).data);
+      }
+      if (poller.has_changed(string_index)) {
+        ROS_INFO("string: %s",
+                 string_context.get_abstract_state<std_msgs::String>(0)
+                     .data.c_str());
+      }
+    }
+    rate.sleep();
+  }
+
+  return 0;
+}
+
+int main(int argc, char* argv[]) {
+  ros::init(argc, argv, "test_subscriber_poller");
+  ros::NodeHandle node_handle;
+
+  return DoMain(node_handle);
+}